@@ -0,0 +1,203 @@
+// AgentStore.cpp
+#include "AgentStore.hpp"
+#include "BehaviorController.hpp"
+#include "MonsterController.hpp"
+#include "CollisionGrid.hpp"
+#include "ThreadPool.hpp"
+
+void AgentStore::reserve(std::size_t n) {
+    positions_.reserve(n);
+    velocities_.reserve(n);
+    orientations_.reserve(n);
+    rotations_.reserve(n);
+    indexToSlot_.reserve(n);
+}
+
+AgentHandle AgentStore::add(const Kinematic& k) {
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = (uint32_t)slotToIndex_.size();
+        slotToIndex_.push_back(0);
+        generations_.push_back(0);
+    }
+    slotToIndex_[slot] = (uint32_t)positions_.size();
+    indexToSlot_.push_back(slot);
+
+    positions_.push_back(k.position);
+    velocities_.push_back(k.velocity);
+    orientations_.push_back(k.orientation);
+    rotations_.push_back(k.rotation);
+    return { slot, generations_[slot] };
+}
+
+std::size_t AgentStore::remove(AgentHandle h) {
+    // a removed agent's slot may already hold someone else: the generation
+    // check keeps a stale handle from deleting them
+    assert(valid(h) && "stale AgentHandle");
+    if (!valid(h))
+        return size();
+    std::size_t i    = slotToIndex_[h.slot];
+    std::size_t last = positions_.size() - 1;
+
+    // move the last agent into the hole
+    positions_[i]    = positions_[last];
+    velocities_[i]   = velocities_[last];
+    orientations_[i] = orientations_[last];
+    rotations_[i]    = rotations_[last];
+    indexToSlot_[i]  = indexToSlot_[last];
+    slotToIndex_[indexToSlot_[i]] = (uint32_t)i;
+
+    positions_.pop_back();
+    velocities_.pop_back();
+    orientations_.pop_back();
+    rotations_.pop_back();
+    indexToSlot_.pop_back();
+
+    ++generations_[h.slot];
+    freeSlots_.push_back(h.slot);
+    return i;
+}
+
+bool AgentStore::valid(AgentHandle h) const {
+    return h.slot < generations_.size()
+        && generations_[h.slot] == h.generation;
+}
+
+AgentHandle AgentStore::handleAt(std::size_t i) const {
+    uint32_t slot = indexToSlot_[i];
+    return { slot, generations_[slot] };
+}
+
+Kinematic AgentStore::get(std::size_t i) const {
+    return { positions_[i], velocities_[i], orientations_[i], rotations_[i] };
+}
+
+void AgentStore::set(std::size_t i, const Kinematic& k) {
+    positions_[i]    = k.position;
+    velocities_[i]   = k.velocity;
+    orientations_[i] = k.orientation;
+    rotations_[i]    = k.rotation;
+}
+
+void AgentStore::integrate(float dt) {
+    std::size_t n = positions_.size();
+    for (std::size_t i = 0; i < n; ++i)
+        positions_[i] += velocities_[i] * dt;
+    for (std::size_t i = 0; i < n; ++i)
+        orientations_[i] = mapToRange(orientations_[i] + rotations_[i] * dt);
+}
+
+// agents that ended up inside a wall go back to prev with zero velocity;
+// agents don't see each other, so testing after everyone moved is the same
+// as testing after each one
+static void clampToWalls(AgentStore& agents, const std::vector<sf::Vector2f>& prev,
+                         const CollisionGrid& collision)
+{
+    static thread_local std::vector<uint8_t> hit;
+    hit.resize(agents.size());
+    collision.blocked(agents.positions(), hit.data(), agents.size());
+    for (std::size_t i = 0; i < agents.size(); ++i) {
+        if (hit[i]) {
+            agents.positions()[i]  = prev[i];
+            agents.velocities()[i] = {0.f,0.f};
+        }
+    }
+}
+
+void stepBehaviorAgents(AgentStore& agents,
+                        const std::vector<BehaviorController*>& ctrls,
+                        const CollisionGrid& collision,
+                        float dt,
+                        ThreadPool* pool)
+{
+    static thread_local std::vector<sf::Vector2f> prev;
+    prev.assign(agents.positions(), agents.positions() + agents.size());
+    auto integrate = [&](std::size_t i, Kinematic& k, const SteeringOutput& s) {
+        k.velocity += s.linear * dt;
+        k.position += k.velocity * dt;
+        k.rotation    += s.angular * dt;
+        k.orientation += k.rotation * dt;
+        k.orientation  = mapToRange(k.orientation);
+        agents.set(i, k);
+    };
+    auto tick = [&](std::size_t begin, std::size_t end) {
+        if (begin == end)
+            return;
+        // one batched table lookup for the whole range when every
+        // controller shares the table
+        const CompiledDecisionTree* table = ctrls[begin]->decisionTable();
+        for (std::size_t i = begin; table && i < end; ++i)
+            if (ctrls[i]->decisionTable() != table)
+                table = nullptr;
+        if (!table) {
+            for (std::size_t i = begin; i < end; ++i) {
+                Kinematic k = agents.get(i);
+                integrate(i, k, ctrls[i]->update(k, dt));
+            }
+            return;
+        }
+        // scratch per thread: ranges run on the pool's threads
+        static thread_local std::vector<Kinematic>    kin;
+        static thread_local std::vector<State>        states;
+        static thread_local std::vector<BehaviorType> chosen;
+        std::size_t n = end - begin;
+        kin.resize(n);
+        states.resize(n);
+        chosen.resize(n);
+        for (std::size_t j = 0; j < n; ++j) {
+            kin[j]    = agents.get(begin + j);
+            states[j] = ctrls[begin + j]->sense(kin[j]);
+        }
+        table->evaluate(states.data(), chosen.data(), n);
+        for (std::size_t j = 0; j < n; ++j)
+            integrate(begin + j, kin[j], ctrls[begin + j]->act(kin[j], chosen[j], dt));
+    };
+    if (pool)
+        pool->parallelFor(agents.size(), 0, tick);
+    else
+        tick(0, agents.size());
+    clampToWalls(agents, prev, collision);
+}
+
+void stepMonsterAgents(AgentStore& agents,
+                       const std::vector<MonsterController*>& ctrls,
+                       Kinematic& player,
+                       const CollisionGrid& collision,
+                       float dt,
+                       ThreadPool* pool)
+{
+    static thread_local std::vector<sf::Vector2f> prev;
+    static thread_local std::vector<Kinematic>    resets;
+    static thread_local std::vector<char>         reset;
+    prev.assign(agents.positions(), agents.positions() + agents.size());
+    resets.resize(agents.size());
+    reset.assign(agents.size(), 0);
+    // every monster reads the player itself, which nothing writes until the
+    // commit below, so shared per-target state (flow fields) sees one
+    // target; a reset teleport goes to the monster's own slot instead.
+    // (references, so pool threads see this thread's vectors rather than
+    // their own thread_local ones)
+    std::vector<Kinematic>& out   = resets;
+    std::vector<char>&      wrote = reset;
+    auto tick = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            Kinematic m = agents.get(i);
+            wrote[i] = ctrls[i]->update(m, player, out[i], dt);
+            agents.set(i, m);
+        }
+    };
+    if (pool)
+        pool->parallelFor(agents.size(), 0, tick);
+    else
+        tick(0, agents.size());
+
+    // commit: writes to the player land in agent order, as a serial pass
+    // over the same snapshot would leave them
+    for (std::size_t i = 0; i < agents.size(); ++i)
+        if (wrote[i])
+            player = out[i];
+    clampToWalls(agents, prev, collision);
+}
@@ -0,0 +1,103 @@
+// AgentStore.hpp
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include "Steering.hpp"     // for Kinematic, SteeringOutput
+
+class BehaviorController;
+class MonsterController;
+class CollisionGrid;
+class ThreadPool;
+
+/// Stable reference to an agent; stays valid while other agents come and go.
+struct AgentHandle {
+    uint32_t slot       = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+/// Kinematic state for many agents kept as parallel arrays (SoA).
+/// Live agents are packed in [0, size()); remove() swaps the last agent into
+/// the hole, and handles are resolved through a slot table so they survive
+/// that move.
+class AgentStore {
+public:
+    void        reserve(std::size_t n);
+    AgentHandle add(const Kinematic& k);
+
+    /// Removes the agent. The agent previously at size()-1 now lives at the
+    /// returned index, so callers can mirror the swap in their own
+    /// per‐agent arrays (e.g. controllers). A stale or default handle is a
+    /// caller bug: it asserts, and otherwise removes nothing and returns
+    /// size().
+    std::size_t remove(AgentHandle h);
+
+    bool        valid(AgentHandle h) const;
+
+    /// Packed index of the agent; size() (asserting) for a stale handle.
+    std::size_t indexOf(AgentHandle h) const {
+        assert(valid(h) && "stale AgentHandle");
+        return valid(h) ? slotToIndex_[h.slot] : size();
+    }
+    AgentHandle handleAt(std::size_t i) const;
+    std::size_t size() const { return positions_.size(); }
+
+    // gather / scatter one agent as a Kinematic
+    Kinematic get(std::size_t i) const;
+    void      set(std::size_t i, const Kinematic& k);
+
+    // packed arrays, indexed [0, size())
+    sf::Vector2f* positions()    { return positions_.data(); }
+    sf::Vector2f* velocities()   { return velocities_.data(); }
+    float*        orientations() { return orientations_.data(); }
+    float*        rotations()    { return rotations_.data(); }
+    const sf::Vector2f* positions()    const { return positions_.data(); }
+    const sf::Vector2f* velocities()   const { return velocities_.data(); }
+    const float*        orientations() const { return orientations_.data(); }
+    const float*        rotations()    const { return rotations_.data(); }
+
+    /// Plain Euler step of every agent (no steering, no walls).
+    void integrate(float dt);
+
+private:
+    std::vector<sf::Vector2f> positions_;
+    std::vector<sf::Vector2f> velocities_;
+    std::vector<float>        orientations_;
+    std::vector<float>        rotations_;
+
+    std::vector<uint32_t> indexToSlot_;   // packed index → slot
+    std::vector<uint32_t> slotToIndex_;   // slot → packed index
+    std::vector<uint32_t> generations_;   // bumped when a slot is freed
+    std::vector<uint32_t> freeSlots_;
+};
+
+// ——— single‐pass drivers ———————————————————————————————————————————
+// ctrls[i] drives the agent at packed index i. With a pool the controllers
+// are ticked in parallel (each touches only its own agent), and the result
+// is identical to pool == nullptr. Controllers must not share mutable
+// services then: flow fields, HPA* and the path scheduler are single
+// threaded (AsyncPathService is fine but makes timing‐dependent results).
+
+/// BehaviorController steering + integration + wall clamp (the part3 player
+/// update) for every agent in the store. The wall test runs once, batched,
+/// after every agent has moved; when the controllers share a compiled
+/// decision table, so does the decision step.
+void stepBehaviorAgents(AgentStore& agents,
+                        const std::vector<BehaviorController*>& ctrls,
+                        const CollisionGrid& collision,
+                        float dt,
+                        ThreadPool* pool = nullptr);
+
+/// MonsterController tick + wall clamp for every agent, all chasing the
+/// same player. Every monster reads `player` itself, which stays as it was
+/// at the start of the frame; writes to it (a reset teleport) are held per
+/// monster and committed after all monsters ran, in agent order.
+void stepMonsterAgents(AgentStore& agents,
+                       const std::vector<MonsterController*>& ctrls,
+                       Kinematic& player,
+                       const CollisionGrid& collision,
+                       float dt,
+                       ThreadPool* pool = nullptr);
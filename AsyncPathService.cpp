@@ -0,0 +1,58 @@
+// AsyncPathService.cpp
+#include "AsyncPathService.hpp"
+#include "PathSearchContext.hpp"
+#include <algorithm>
+
+std::shared_ptr<const NavGraph> snapshotNavGraph() {
+    return std::make_shared<const NavGraph>(navGraph);
+}
+
+AsyncPathService::AsyncPathService(std::shared_ptr<const NavGraph> graph, unsigned threads)
+  : graph_(std::move(graph))
+{
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    workers_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        workers_.emplace_back(&AsyncPathService::run, this);
+}
+
+AsyncPathService::~AsyncPathService() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : workers_)
+        t.join();
+    // unfinished jobs: their futures see broken_promise
+}
+
+std::future<std::vector<int>> AsyncPathService::request(int startIdx, int goalIdx) {
+    std::future<std::vector<int>> f;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back({ startIdx, goalIdx, {} });
+        f = jobs_.back().result.get_future();
+    }
+    wake_.notify_one();
+    return f;
+}
+
+void AsyncPathService::run() {
+    PathSearchContext ctx(*graph_);
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_)
+                return;
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        std::vector<int> path;
+        ctx.search(job.start, job.goal, path);
+        job.result.set_value(std::move(path));
+    }
+}
@@ -0,0 +1,56 @@
+// AsyncPathService.hpp
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "NavGraph.hpp"
+
+/// A* on a pool of worker threads. Every worker owns a PathSearchContext
+/// over the same immutable NavGraph snapshot, so searches share nothing
+/// mutable with the simulation thread. request() returns a future; agents
+/// check it with ready() on later ticks and keep doing what they were doing
+/// meanwhile. An empty result means no path.
+class AsyncPathService {
+public:
+    /// threads == 0 uses std::thread::hardware_concurrency().
+    explicit AsyncPathService(std::shared_ptr<const NavGraph> graph,
+                              unsigned threads = 0);
+    ~AsyncPathService();
+
+    AsyncPathService(const AsyncPathService&)            = delete;
+    AsyncPathService& operator=(const AsyncPathService&) = delete;
+
+    std::future<std::vector<int>> request(int startIdx, int goalIdx);
+
+    unsigned threads() const { return (unsigned)workers_.size(); }
+    const NavGraph& graph() const { return *graph_; }
+
+    /// True once f holds a result (false for an empty future).
+    static bool ready(const std::future<std::vector<int>>& f) {
+        return f.valid() &&
+               f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+private:
+    struct Job {
+        int start, goal;
+        std::promise<std::vector<int>> result;
+    };
+
+    std::shared_ptr<const NavGraph> graph_;
+    std::vector<std::thread>        workers_;
+    std::deque<Job>                 jobs_;
+    std::mutex                      mutex_;
+    std::condition_variable         wake_;
+    bool                            stopping_ = false;
+
+    void run();
+};
+
+/// Immutable copy of the global navGraph for AsyncPathService.
+std::shared_ptr<const NavGraph> snapshotNavGraph();
@@ -1,18 +1,36 @@
 #pragma once
 #include "Steering.hpp"     // for Kinematic
 #include "Node.hpp"         // for graphNodes if you need A*
+#include "Rng.hpp"
+#include "MonsterAction.hpp"
 #include <vector>
 #include <SFML/Graphics.hpp> // for sf::RectangleShape
 
 enum class Status { Success, Failure, Running };
 
+class RoutingTable;
+class FlowFieldService;
+class HierarchicalPlanner;
+class PathScheduler;
+class AsyncPathService;
+
 struct WorldState {
     Kinematic*                                monster;
     Kinematic*                                player;
+    Kinematic*                                playerOut;  // where ResetTask teleports the player (nullptr = player)
+    bool                                      wrotePlayer; // set by ResetTask when it wrote playerOut
     const std::vector<Node>*                 graphNodes;
     const std::vector<sf::RectangleShape>*    walls;
     float                                     eatRadius;
-    std::string                               lastAction;
+    const RoutingTable*                       routes;     // optional next‐hop table for chasing
+    FlowFieldService*                         flowFields; // optional shared per‐player flow fields
+    bool                                      incrementalChase;  // chase with D* Lite instead of A*
+    HierarchicalPlanner*                      hpa;        // optional HPA* for long wander trips
+    PathScheduler*                            scheduler;  // optional time‐sliced A* queue
+    AsyncPathService*                         asyncPaths; // optional A* on worker threads
+    Rng                                       rng;        // this monster's random draws
+    bool                                      justReset;  // set by ResetTask, cleared by the first task to see it
+    MonsterAction                             lastAction; // set by whichever task ran
 };
 
 struct BTNode {
@@ -3,7 +3,10 @@
 #include "ConditionNode.hpp"
 #include "ActionNode.hpp"
 #include "Node.hpp"
-#include <cstdlib>    // for rand()
+#include "PathSearchContext.hpp"
+#include "DistanceField.hpp"
+#include "AsyncPathService.hpp"
+#include "Environment.hpp"      // for wallDistance
 #include <limits>
 #include <cmath>
 
@@ -13,14 +16,19 @@
 BehaviorController::BehaviorController(const std::vector<Node>& graph,
                                        const std::vector<sf::RectangleShape>& walls)
   : root_(BehaviorTreeFactory::buildBehaviorTree())
+  , table_(BehaviorTreeFactory::compiledBehaviorTree().empty()
+             ? nullptr : &BehaviorTreeFactory::compiledBehaviorTree())
   , lastBehavior_(BehaviorType::PickNewWaypoint)
   , timeInBehavior_(0.f)
   , graphNodes_(graph)
   , walls_(walls)
+  , distanceField_(nullptr)
+  , asyncPaths_(nullptr)
   // tune these params as you like
   , arrive_(250.f, 300.f, 15.f, 300.f, 0.3f)
   , align_(200.f, PI * 3, 0.02f, 2.0f, 0.1f)
   , wander_(150.f, 150.f, 50.f, 30.f, 10.f, 0.4f)
+  , rng_(Rng::agentSeed())
   , currentWaypoint_(-1)
   , currentPathIndex_(0)
 {
@@ -30,6 +38,11 @@ BehaviorController::BehaviorController(const std::vector<Node>& graph,
 }
 
 SteeringOutput BehaviorController::update(Kinematic& character, float dt) {
+    sense(character);
+    return act(character, decide(), dt);
+}
+
+const State& BehaviorController::sense(const Kinematic& character) {
     // 1) Update State
     state_.distanceToTarget = std::hypot(
         character.position.x - graphNodes_[currentWaypoint_].position.x,
@@ -38,15 +51,21 @@ SteeringOutput BehaviorController::update(Kinematic& character, float dt) {
     state_.speed         = vectorLength(character.velocity);
     state_.minWallDist   = computeMinWallDist(character.position);
     state_.timeInBehavior = timeInBehavior_;
+    return state_;
+}
 
-    // 2) Traverse tree
+BehaviorType BehaviorController::decide() {
+    // 2) Traverse tree: by table, or node by node
+    if (table_)
+        return table_->evaluate(state_);
     DecisionNode* node = root_;
     while (auto* cond = dynamic_cast<ConditionNode*>(node)) {
         node = cond->evaluate(state_);
     }
-    auto* action = static_cast<ActionNode*>(node);
-    auto  behavior = action->getBehavior();
+    return static_cast<ActionNode*>(node)->getBehavior();
+}
 
+SteeringOutput BehaviorController::act(Kinematic& character, BehaviorType behavior, float dt) {
     // 3) Behavior‑change logic
     if (behavior != lastBehavior_) {
         timeInBehavior_ = 0.f;
@@ -61,6 +80,18 @@ SteeringOutput BehaviorController::update(Kinematic& character, float dt) {
             pickNewWaypoint(character);
             return {};  // no steering this frame
             case BehaviorType::Pathfind: {
+                // path still being searched on a worker: hold
+                if (pendingPath_.valid()) {
+                    if (!AsyncPathService::ready(pendingPath_))
+                        return {};
+                    currentPath_ = pendingPath_.get();
+                }
+                // unreachable waypoint (or an empty async result): the tree
+                // only picks again on arrival, so pick here or stay put forever
+                if (currentPath_.empty()) {
+                    pickNewWaypoint(character);
+                    return {};
+                }
                 // 1) Which node we’re aiming at
                 sf::Vector2f targetPos = graphNodes_[ currentPath_[currentPathIndex_] ].position;
             
@@ -99,6 +130,11 @@ SteeringOutput BehaviorController::update(Kinematic& character, float dt) {
     return {};
 }
 
+void BehaviorController::seed(uint64_t s) {
+    rng_.seed(s);
+    wander_.seed(rng_.next());
+}
+
 void BehaviorController::initialize(Kinematic& character) {
     pickNewWaypoint(character);
 }
@@ -106,22 +142,18 @@ void BehaviorController::initialize(Kinematic& character) {
 
 void BehaviorController::pickNewWaypoint(Kinematic& character) {
     int start = getClosestNode(character.position);
-    currentWaypoint_ = std::rand() % graphNodes_.size();
-    currentPath_     = AStar(start, currentWaypoint_);
+    currentWaypoint_ = rng_.below((int)graphNodes_.size());
+    if (asyncPaths_) {
+        currentPath_.clear();
+        pendingPath_ = asyncPaths_->request(start, currentWaypoint_);
+    } else {
+        threadPathContext().search(start, currentWaypoint_, currentPath_);
+    }
     currentPathIndex_ = 0;
 }
 
 float BehaviorController::computeMinWallDist(const sf::Vector2f& pos) const {
-    float best = std::numeric_limits<float>::infinity();
-    for (auto& w : walls_) {
-        // axis‑aligned distance to rectangle
-        float dx = std::max({ w.getPosition().x - pos.x,
-                              pos.x - (w.getPosition().x + w.getSize().x),
-                              0.f });
-        float dy = std::max({ w.getPosition().y - pos.y,
-                              pos.y - (w.getPosition().y + w.getSize().y),
-                              0.f });
-        best = std::min(best, std::hypot(dx, dy));
-    }
-    return best;
+    if (distanceField_)
+        return distanceField_->sample(pos);
+    return wallDistance(pos, walls_);
 }
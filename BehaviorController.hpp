@@ -8,7 +8,10 @@
 #include "BehaviorTreeFactory.hpp"
 #include "Node.hpp"
 #include <vector>
+#include <future>
 
+class DistanceField;
+class AsyncPathService;
 
 
 class BehaviorController {
@@ -18,21 +21,47 @@ public:
 
     /// Call each frame: returns the steering for the chosen behavior.
     SteeringOutput update(Kinematic& character, float deltaTime);
+
+    // update() in three steps, for drivers that decide for many agents in
+    // one batch (CompiledDecisionTree::evaluate over every sense() result)
+    const State&   sense(const Kinematic& character);
+    BehaviorType   decide();
+    SteeringOutput act(Kinematic& character, BehaviorType behavior, float deltaTime);
+
+    /// The decision table shared by every controller, or nullptr when the
+    /// tree can't be compiled and decide() walks it instead.
+    const CompiledDecisionTree* decisionTable() const { return table_; }
     void initialize(Kinematic& character);
 
+    /// Sense wall distance from a precomputed field instead of scanning
+    /// every wall (nullptr = exact scan).
+    void setDistanceField(const DistanceField* field) { distanceField_ = field; }
+
+    /// Search new waypoint paths on worker threads; the character holds
+    /// still until the path arrives (nullptr = search inline).
+    void setAsyncPaths(AsyncPathService* service) { asyncPaths_ = service; }
+
+    /// Fix this controller's random draws (waypoints and wander jitter).
+    void seed(uint64_t s);
+
 private:
     DecisionNode*              root_;
+    const CompiledDecisionTree* table_;
     BehaviorType               lastBehavior_;
     float                      timeInBehavior_;
 
     // dependencies
     const std::vector<Node>& graphNodes_;  // now works, Node is complete
     const std::vector<sf::RectangleShape>& walls_;
+    const DistanceField*                   distanceField_;
+    AsyncPathService*                      asyncPaths_;
+    std::future<std::vector<int>>          pendingPath_;
 
     // steering instances
     ArriveBehavior arrive_;
     AlignBehavior  align_;
     WanderBehavior wander_;
+    Rng            rng_;
 
     // path state
     int               currentWaypoint_;
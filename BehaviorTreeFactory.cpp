@@ -12,8 +12,9 @@ DecisionNode* buildBehaviorTree() {
 
     // If we’re at our node-target → pick a brand-new waypoint
     // else → keep following the current path
+    // (s.atTarget(), in the structured form so it compiles to a table)
     DecisionNode* root = new ConditionNode(
-        [](const State& s){ return s.atTarget(); },
+        StateFeature::DistanceToTarget, Compare::Less, State::targetEpsilon,
         pickWP,
         pathfind
     );
@@ -21,4 +22,14 @@ DecisionNode* buildBehaviorTree() {
     return root;
 }
 
+const CompiledDecisionTree& compiledBehaviorTree() {
+    static const CompiledDecisionTree table = []{
+        DecisionNode* root = buildBehaviorTree();
+        CompiledDecisionTree t;
+        t.compile(root);
+        return t;
+    }();
+    return table;
+}
+
 } // namespace BehaviorTreeFactory
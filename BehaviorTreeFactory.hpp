@@ -2,8 +2,12 @@
 #pragma once
 
 #include "DecisionNode.hpp"
+#include "CompiledDecisionTree.hpp"
 
 namespace BehaviorTreeFactory {
     /// Build & return the root of your hand‑crafted tree.
     DecisionNode* buildBehaviorTree();
+
+    /// buildBehaviorTree() lowered to a table, built once and shared.
+    const CompiledDecisionTree& compiledBehaviorTree();
 }
@@ -0,0 +1,115 @@
+// CollisionGrid.cpp
+#include "CollisionGrid.hpp"
+#include <algorithm>
+#include <cmath>
+
+void CollisionGrid::build(const std::vector<sf::RectangleShape>& walls, float cellSize) {
+    walls_ = &walls;
+    count_ = walls.size();
+    cell_  = cellSize;
+    state_.clear();
+    listStart_.assign(1, 0);
+    wallList_.clear();
+    rects_.clear();
+    boundaryCells_ = 0;
+    cols_ = rows_ = 0;
+    if (walls.empty() || cellSize <= 0.f)
+        return;
+
+    // getGlobalBounds() rebuilds the transform, so take it once per wall
+    rects_.reserve(walls.size());
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (auto& w : walls) {
+        sf::FloatRect b = w.getGlobalBounds();
+        rects_.push_back(b);
+        minX = std::min(minX, std::min(b.left, b.left + b.width));
+        maxX = std::max(maxX, std::max(b.left, b.left + b.width));
+        minY = std::min(minY, std::min(b.top,  b.top  + b.height));
+        maxY = std::max(maxY, std::max(b.top,  b.top  + b.height));
+    }
+    originX_ = minX;
+    originY_ = minY;
+    cols_ = std::max(1, (int)std::ceil((maxX - minX) / cell_));
+    rows_ = std::max(1, (int)std::ceil((maxY - minY) / cell_));
+    const std::size_t cells = (std::size_t)cols_ * rows_;
+    state_.assign(cells, Free);
+
+    // visit(wall, cell, covered) for every cell a wall touches. Cells are
+    // padded by a hair so a point that rounds into a neighboring cell still
+    // sees the walls near it.
+    const float pad = 1e-3f * cell_;
+    auto forCellsOf = [&](auto visit) {
+        for (uint32_t wi = 0; wi < rects_.size(); ++wi) {
+            const sf::FloatRect& b = rects_[wi];
+            float l = std::min(b.left, b.left + b.width), r = std::max(b.left, b.left + b.width);
+            float t = std::min(b.top,  b.top  + b.height), d = std::max(b.top, b.top  + b.height);
+            int i0 = std::max(0, (int)std::floor((l - pad - originX_) / cell_));
+            int i1 = std::min(cols_ - 1, (int)std::floor((r + pad - originX_) / cell_));
+            int j0 = std::max(0, (int)std::floor((t - pad - originY_) / cell_));
+            int j1 = std::min(rows_ - 1, (int)std::floor((d + pad - originY_) / cell_));
+            for (int j = j0; j <= j1; ++j) {
+                float y0 = originY_ + j * cell_ - pad, y1 = originY_ + (j + 1) * cell_ + pad;
+                for (int i = i0; i <= i1; ++i) {
+                    float x0 = originX_ + i * cell_ - pad, x1 = originX_ + (i + 1) * cell_ + pad;
+                    if (x0 < r && l < x1 && y0 < d && t < y1)
+                        visit(wi, (std::size_t)j * cols_ + i,
+                              l <= x0 && x1 <= r && t <= y0 && y1 <= d);
+                }
+            }
+        }
+    };
+
+    // 1) cells inside one wall outright
+    forCellsOf([&](uint32_t, std::size_t c, bool covered) {
+        if (covered) state_[c] = Full;
+    });
+    // 2) count, then list, the walls touching each remaining cell
+    listStart_.assign(cells + 1, 0);
+    forCellsOf([&](uint32_t, std::size_t c, bool) {
+        if (state_[c] != Full) ++listStart_[c + 1];
+    });
+    for (std::size_t c = 0; c < cells; ++c) {
+        if (state_[c] != Full && listStart_[c + 1] > 0) {
+            state_[c] = Boundary;
+            ++boundaryCells_;
+        }
+        listStart_[c + 1] += listStart_[c];
+    }
+    wallList_.resize(listStart_[cells]);
+    std::vector<uint32_t> fill(listStart_.begin(), listStart_.end() - 1);
+    forCellsOf([&](uint32_t wi, std::size_t c, bool) {
+        if (state_[c] == Boundary) wallList_[fill[c]++] = wi;
+    });
+}
+
+bool CollisionGrid::test(float x, float y) const {
+    int i = (int)std::floor((x - originX_) / cell_);
+    int j = (int)std::floor((y - originY_) / cell_);
+    if (i < 0 || j < 0 || i >= cols_ || j >= rows_)
+        return false;
+    std::size_t c = (std::size_t)j * cols_ + i;
+    uint8_t s = state_[c];
+    if (s != Boundary)
+        return s == Full;
+    sf::Vector2f p(x, y);
+    for (uint32_t k = listStart_[c]; k < listStart_[c + 1]; ++k)
+        if (rects_[wallList_[k]].contains(p))
+            return true;
+    return false;
+}
+
+bool CollisionGrid::blocked(const sf::Vector2f& pos) const {
+    return test(pos.x, pos.y);
+}
+
+void CollisionGrid::blocked(const sf::Vector2f* pos, uint8_t* out, std::size_t n) const {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = test(pos[i].x, pos[i].y) ? 1 : 0;
+}
+
+std::size_t CollisionGrid::bytes() const {
+    return state_.capacity() * sizeof(uint8_t)
+         + listStart_.capacity() * sizeof(uint32_t)
+         + wallList_.capacity() * sizeof(uint32_t)
+         + rects_.capacity() * sizeof(sf::FloatRect);
+}
@@ -0,0 +1,48 @@
+// CollisionGrid.hpp
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/// Static walls pre‐rasterized into square cells over their bounding box:
+/// a cell is free (no wall touches it), full (inside one wall) or boundary
+/// (partly covered; keeps the list of walls touching it). A point query is
+/// one cell lookup, plus exact bounds tests against a handful of walls in
+/// boundary cells, and gives the same answer as isInsideWall().
+///
+/// Rebuild if the walls change.
+class CollisionGrid {
+public:
+    void build(const std::vector<sf::RectangleShape>& walls, float cellSize = 8.f);
+
+    /// True if built for exactly this wall vector.
+    bool covers(const std::vector<sf::RectangleShape>& walls) const {
+        return walls_ == &walls && count_ == walls.size();
+    }
+
+    bool blocked(const sf::Vector2f& pos) const;
+
+    /// out[i] = blocked(pos[i]) for many agents at once.
+    void blocked(const sf::Vector2f* pos, uint8_t* out, std::size_t n) const;
+
+    std::size_t boundaryCells() const { return boundaryCells_; }
+    std::size_t bytes() const;
+
+private:
+    enum : uint8_t { Free = 0, Full = 1, Boundary = 2 };
+
+    const std::vector<sf::RectangleShape>* walls_ = nullptr;
+    std::size_t                count_   = 0;
+    float                      cell_    = 8.f;
+    float                      originX_ = 0.f, originY_ = 0.f;
+    int                        cols_    = 0,   rows_    = 0;
+    std::vector<uint8_t>       state_;       // per cell
+    std::vector<uint32_t>      listStart_;   // per cell + 1, into wallList_
+    std::vector<uint32_t>      wallList_;    // walls touching each boundary cell
+    std::vector<sf::FloatRect> rects_;       // cached wall bounds
+    std::size_t                boundaryCells_ = 0;
+
+    bool test(float x, float y) const;
+};
@@ -0,0 +1,74 @@
+// CompiledDecisionTree.cpp
+#include "CompiledDecisionTree.hpp"
+#include "ConditionNode.hpp"
+#include "ActionNode.hpp"
+#include <algorithm>
+
+bool CompiledDecisionTree::compile(const DecisionNode* root) {
+    rows_.clear();
+    depth_ = 0;
+    int32_t ref;
+    if (!root || !lower(root, 0, ref)) {
+        rows_.clear();
+        root_ = kNone;
+        return false;
+    }
+    root_ = ref;
+    return true;
+}
+
+bool CompiledDecisionTree::lower(const DecisionNode* node, int level, int32_t& ref) {
+    if (auto* leaf = dynamic_cast<const ActionNode*>(node)) {
+        ref = ~int32_t(leaf->getBehavior());
+        depth_ = std::max(depth_, level);
+        return true;
+    }
+    auto* cond = dynamic_cast<const ConditionNode*>(node);
+    if (!cond || !cond->structured() || !cond->trueBranch() || !cond->falseBranch())
+        return false;
+
+    ref = (int32_t)rows_.size();
+    Row r;
+    r.feature   = cond->feature();
+    r.sign      = cond->op() == Compare::Less ? 1.f : -1.f;
+    r.threshold = r.sign * cond->threshold();
+    rows_.push_back(r);
+
+    int32_t t, f;
+    if (!lower(cond->trueBranch(), level + 1, t) ||
+        !lower(cond->falseBranch(), level + 1, f))
+        return false;
+    rows_[ref].next[1] = t;
+    rows_[ref].next[0] = f;
+    return true;
+}
+
+void CompiledDecisionTree::evaluate(const State* states, BehaviorType* out,
+                                    std::size_t n) const
+{
+    const std::size_t kBlock = 256;
+    float   cols[4][kBlock];
+    int32_t ref[kBlock];
+    for (std::size_t base = 0; base < n; base += kBlock) {
+        std::size_t m = std::min(kBlock, n - base);
+        for (std::size_t k = 0; k < m; ++k) {
+            const State& s = states[base + k];
+            cols[0][k] = s.distanceToTarget;
+            cols[1][k] = s.timeInBehavior;
+            cols[2][k] = s.minWallDist;
+            cols[3][k] = s.speed;
+            ref[k]     = root_;
+        }
+        // every agent is at most depth_ conditions from a leaf
+        for (int level = 0; level < depth_; ++level) {
+            for (std::size_t k = 0; k < m; ++k) {
+                if (ref[k] < 0)
+                    continue;
+                const Row& r = rows_[ref[k]];
+                ref[k] = r.next[r.sign * cols[int(r.feature)][k] < r.threshold];
+            }
+        }
+        for (std::size_t k = 0; k < m; ++k)
+            out[base + k] = BehaviorType(~ref[k]);
+    }
+}
@@ -0,0 +1,58 @@
+// CompiledDecisionTree.hpp
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "State.hpp"
+#include "ActionNode.hpp"   // for BehaviorType
+
+class DecisionNode;
+
+/// A DecisionNode tree lowered to a table: one row per condition holding
+/// (feature, threshold, true child, false child), leaves folded into the
+/// child references. Evaluating it is a loop of loads and a select, with
+/// no dynamic_cast or std::function call per level.
+///
+/// Only structured ConditionNodes (feature + threshold) can be lowered;
+/// compile() fails on a tree with predicate lambdas, and callers keep
+/// walking the node tree in that case.
+class CompiledDecisionTree {
+public:
+    /// Lowers the tree under root; false (and empty()) if it can't be.
+    bool compile(const DecisionNode* root);
+
+    bool        empty() const { return root_ == kNone; }
+    std::size_t rows()  const { return rows_.size(); }
+    int         depth() const { return depth_; }
+
+    BehaviorType evaluate(const State& state) const {
+        int32_t ref = root_;
+        while (ref >= 0) {
+            const Row& r = rows_[ref];
+            ref = r.next[r.sign * state.feature(r.feature) < r.threshold];
+        }
+        return BehaviorType(~ref);
+    }
+
+    /// out[i] = evaluate(states[i]). Gathers the features into columns and
+    /// walks all agents one level at a time.
+    void evaluate(const State* states, BehaviorType* out, std::size_t n) const;
+
+private:
+    // v < t as sign*v < sign*t with sign = +1, and v > t with sign = -1
+    struct Row {
+        StateFeature feature;
+        float        sign;
+        float        threshold;     // already multiplied by sign
+        int32_t      next[2];       // [false, true]: row index, or ~BehaviorType
+    };
+
+    static const int32_t kNone = INT32_MIN;
+
+    std::vector<Row> rows_;
+    int32_t          root_  = kNone;
+    int              depth_ = 0;    // conditions on the longest path
+
+    bool lower(const DecisionNode* node, int level, int32_t& ref);
+};
@@ -9,6 +9,20 @@ ConditionNode::ConditionNode(Predicate predicate,
   , falseBranch_(onFalse)
 {}
 
+ConditionNode::ConditionNode(StateFeature feature, Compare op, float threshold,
+                             DecisionNode* onTrue,
+                             DecisionNode* onFalse)
+  : feature_(feature)
+  , op_(op)
+  , threshold_(threshold)
+  , trueBranch_(onTrue)
+  , falseBranch_(onFalse)
+{}
+
 DecisionNode* ConditionNode::evaluate(const State& state) {
-    return predicate_(state) ? trueBranch_ : falseBranch_;
+    if (predicate_)
+        return predicate_(state) ? trueBranch_ : falseBranch_;
+    float v = state.feature(feature_);
+    bool  t = op_ == Compare::Less ? v < threshold_ : v > threshold_;
+    return t ? trueBranch_ : falseBranch_;
 }
@@ -4,7 +4,11 @@
 #include "DecisionNode.hpp"
 #include <functional>
 
+enum class Compare : uint8_t { Less, Greater };
+
 // A binary decision node: if predicate(state) is true → onTrue, else → onFalse.
+// The structured form tests one State feature against a threshold and can
+// be compiled into a CompiledDecisionTree; an arbitrary predicate can't.
 class ConditionNode : public DecisionNode {
 public:
     using Predicate = std::function<bool(const State&)>;
@@ -13,10 +17,25 @@ public:
                   DecisionNode* onTrue,
                   DecisionNode* onFalse);
 
+    /// state.feature(feature) < threshold (or >) → onTrue, else → onFalse.
+    ConditionNode(StateFeature feature, Compare op, float threshold,
+                  DecisionNode* onTrue,
+                  DecisionNode* onFalse);
+
     DecisionNode* evaluate(const State& state) override;
 
+    bool          structured()  const { return !predicate_; }
+    StateFeature  feature()     const { return feature_; }
+    Compare       op()          const { return op_; }
+    float         threshold()   const { return threshold_; }
+    DecisionNode* trueBranch()  const { return trueBranch_; }
+    DecisionNode* falseBranch() const { return falseBranch_; }
+
 private:
-    Predicate       predicate_;
+    Predicate       predicate_;     // empty in the structured form
+    StateFeature    feature_   = StateFeature::DistanceToTarget;
+    Compare         op_        = Compare::Less;
+    float           threshold_ = 0.f;
     DecisionNode*   trueBranch_;
     DecisionNode*   falseBranch_;
 };
@@ -1,20 +1,100 @@
 #include "DataRecorder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
-DataRecorder::DataRecorder(const std::string& filename)
-  : out_(filename)
+static const char kSampleMagic[4] = { 'M', 'S', 'M', 'P' };
+
+SampleFileHeader sampleFileHeader() {
+    SampleFileHeader h;
+    std::memcpy(h.magic, kSampleMagic, 4);
+    h.version    = kSampleFileVersion;
+    h.recordSize = sizeof(SampleRecord);
+    h.reserved   = 0;
+    return h;
+}
+
+bool isSampleFileHeader(const SampleFileHeader& h) {
+    return std::memcmp(h.magic, kSampleMagic, 4) == 0 &&
+           h.version == kSampleFileVersion &&
+           h.recordSize == sizeof(SampleRecord);
+}
+
+// round up to a power of two so slots are head & mask
+static std::size_t ringSize(std::size_t capacity) {
+    std::size_t n = 1024;
+    while (n < capacity) n <<= 1;
+    return n;
+}
+
+DataRecorder::DataRecorder(const std::string& filename, std::size_t capacity)
+  : file_(std::fopen(filename.c_str(), "wb")),
+    ring_(ringSize(capacity)),
+    mask_(ring_.size() - 1)
 {
-    out_ << "room,dist,aggro,wall,action\n";
+    if (!file_) {
+        failed_ = true;
+        return;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+    SampleFileHeader h = sampleFileHeader();
+    if (std::fwrite(&h, sizeof(h), 1, file_) != 1)
+        failed_ = true;
+    writer_ = std::thread([this] { drain(); });
 }
 
-DataRecorder::~DataRecorder() {
-    out_.close();
+void DataRecorder::close() {
+    if (!file_)
+        return;
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+    if (std::fclose(file_) != 0)
+        failed_ = true;
+    file_ = nullptr;
 }
 
 void DataRecorder::record(const Sample& s) {
-    out_
-      << s.roomId << "," 
-      << s.distToPlayer << ","
-      << (s.inAggro?1:0) << ","
-      << (s.hittingWall?1:0) << ","
-      << s.action << "\n";
+    if (!file_)
+        return;
+    std::size_t head = head_.load(std::memory_order_relaxed);
+    if (head - cachedTail_ == ring_.size()) {
+        // only look at the writer's position when the cached one says full
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+        if (head - cachedTail_ == ring_.size()) {
+            ++stalls_;
+            do {
+                std::this_thread::yield();
+                cachedTail_ = tail_.load(std::memory_order_acquire);
+            } while (head - cachedTail_ == ring_.size());
+        }
+    }
+    ring_[head & mask_] = packSample(s);
+    head_.store(head + 1, std::memory_order_release);
+    ++recorded_;
+}
+
+void DataRecorder::drain() {
+    std::size_t tail = tail_.load(std::memory_order_relaxed);
+    for (;;) {
+        // stop_ before head_: once stopping is seen, head_ is final
+        bool        stopping = stop_.load(std::memory_order_acquire);
+        std::size_t head     = head_.load(std::memory_order_acquire);
+        if (head == tail) {
+            if (stopping)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        // everything queued, in at most two runs (the ring wraps)
+        while (tail != head) {
+            std::size_t at = tail & mask_;
+            std::size_t n  = std::min(head - tail, ring_.size() - at);
+            if (std::fwrite(&ring_[at], sizeof(SampleRecord), n, file_) != n)
+                failed_.store(true, std::memory_order_relaxed);
+            tail += n;
+            tail_.store(tail, std::memory_order_release);
+        }
+    }
+    if (std::fflush(file_) != 0)
+        failed_.store(true, std::memory_order_relaxed);
 }
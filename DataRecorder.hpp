@@ -1,23 +1,122 @@
 #pragma once
-#include <fstream>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
 #include <vector>
 #include <string>
 #include "Node.hpp"
 #include "Steering.hpp"
+#include "MonsterAction.hpp"
 
 struct Sample {
     int   roomId;          // which room the monster is in (e.g. 0–3)
     float distToPlayer;    // Euclidean distance to player
     bool  inAggro;         // distToPlayer < aggroRange?
     bool  hittingWall;     // is the next step blocked?
-    std::string action;    // “wander” or “chase” or “reset”
+    MonsterAction action;  // wander, chase or reset
 };
 
+// ——— file format —————————————————————————————————————————————————
+//
+// A SampleFileHeader, then one SampleRecord per Sample, fixed width and in
+// host order (little endian on every target this builds for).
+// samples2csv turns a file back into the old monster_data.csv text.
+
+static const uint32_t kSampleFileVersion = 1;
+
+struct SampleFileHeader {
+    char     magic[4];     // "MSMP"
+    uint32_t version;      // kSampleFileVersion
+    uint32_t recordSize;   // sizeof(SampleRecord)
+    uint32_t reserved;
+};
+
+enum : uint8_t {
+    kSampleAggro = 1 << 0,
+    kSampleWall  = 1 << 1,
+};
+
+struct SampleRecord {
+    float   dist;
+    uint8_t room;
+    uint8_t flags;         // kSampleAggro | kSampleWall
+    uint8_t action;        // MonsterAction
+    uint8_t pad;
+};
+
+static_assert(sizeof(SampleFileHeader) == 16, "header layout changed");
+static_assert(sizeof(SampleRecord) == 8, "record layout changed");
+
+SampleFileHeader sampleFileHeader();
+bool             isSampleFileHeader(const SampleFileHeader& h);
+
+inline SampleRecord packSample(const Sample& s) {
+    SampleRecord r;
+    r.dist   = s.distToPlayer;
+    r.room   = uint8_t(s.roomId);
+    r.flags  = uint8_t((s.inAggro ? kSampleAggro : 0) | (s.hittingWall ? kSampleWall : 0));
+    r.action = uint8_t(s.action);
+    r.pad    = 0;
+    return r;
+}
+
+inline Sample unpackSample(const SampleRecord& r) {
+    Sample s;
+    s.roomId       = r.room;
+    s.distToPlayer = r.dist;
+    s.inAggro      = (r.flags & kSampleAggro) != 0;
+    s.hittingWall  = (r.flags & kSampleWall) != 0;
+    s.action       = MonsterAction(r.action);
+    return s;
+}
+
+// ——— recorder ————————————————————————————————————————————————————
+
+/// Writes Samples to a file in the format above. record() only packs the
+/// sample into a single‐producer ring; a writer thread drains the ring to
+/// disk in blocks, so the frame that records never formats or touches the
+/// file. Call record() from one thread at a time. If the writer falls a
+/// whole ring behind, record() waits for it rather than dropping samples.
 class DataRecorder {
 public:
-    DataRecorder(const std::string& filename);
-    ~DataRecorder();
+    explicit DataRecorder(const std::string& filename,
+                          std::size_t capacity = std::size_t(1) << 18);
+    ~DataRecorder() { close(); }
+
+    DataRecorder(const DataRecorder&)            = delete;
+    DataRecorder& operator=(const DataRecorder&) = delete;
+
+    /// False if the file couldn't be created or a write failed; after
+    /// close(), covers every sample recorded.
+    bool ok() const { return !failed_.load(std::memory_order_relaxed); }
+
+    /// Writes whatever is still queued and closes the file; record() does
+    /// nothing afterwards.
+    void close();
+
     void record(const Sample& s);
+
+    /// Samples recorded, and how many of those had to wait for the writer.
+    long long recorded() const { return recorded_; }
+    long long stalls()   const { return stalls_; }
+
 private:
-    std::ofstream out_;
+    std::FILE*                file_;
+    std::vector<SampleRecord> ring_;
+    std::size_t               mask_;
+
+    // producer side
+    alignas(64) std::atomic<std::size_t> head_{0};   // next slot to fill
+    std::size_t               cachedTail_ = 0;
+    long long                 recorded_   = 0;
+    long long                 stalls_     = 0;
+
+    // writer side
+    alignas(64) std::atomic<std::size_t> tail_{0};   // next slot to write
+    std::atomic<bool>         stop_{false};
+    std::atomic<bool>         failed_{false};
+    std::thread               writer_;
+
+    void drain();
 };
@@ -1,28 +1,29 @@
 #include "DecisionTreeController.hpp"
+#include "Environment.hpp"     // for getRoomId, isInsideWall
 
 DecisionTreeController::DecisionTreeController(const nlohmann::json& tree)
- : tree_(tree)
+{
+    tree_.compile(tree, &error_);
+}
+
+DecisionTreeController::DecisionTreeController(LearnedTreeFn tree)
+ : fn_(tree)
 {}
 
-std::string DecisionTreeController::evaluate(
-    const nlohmann::json& node,
-    int room, float dist, bool aggro, bool wallHit)
+MonsterAction DecisionTreeController::decide(
+    const Kinematic& M,
+    const Kinematic& P,
+    const std::vector<sf::RectangleShape>& walls) const
 {
-    if (node.contains("label"))
-        return node["label"];
-    auto a = node["attr"].get<std::string>();
-    if (a=="dist") {
-        if (dist <= node["thresh"].get<float>())
-            return evaluate(node["le"], room, dist, aggro, wallHit);
-        else
-            return evaluate(node["gt"], room, dist, aggro, wallHit);
-    } else {
-        int v = (a=="room" ? room
-              : a=="aggro"? aggro
-              : /*wall*/    wallHit);
-        return evaluate(node["branches"][std::to_string(v)],
-                        room, dist, aggro, wallHit);
-    }
+    // compute the same features the samples were recorded with:
+    MonsterFeatures f;
+    f.room  = getRoomId(M.position);
+    f.dist  = vectorLength(P.position - M.position);
+    f.aggro = f.dist < 400.f;
+    sf::Vector2f probe = M.position +
+        sf::Vector2f(std::cos(M.orientation),std::sin(M.orientation))*10.f;
+    f.wall  = isInsideWall(probe, walls);
+    return fn_ ? fn_(f) : tree_.evaluate(f);
 }
 
 SteeringOutput DecisionTreeController::update(
@@ -31,21 +32,13 @@ SteeringOutput DecisionTreeController::update(
     const std::vector<sf::RectangleShape>& walls,
     float dt)
 {
-    // compute the same features:
-    int room = /* your room‑id logic */;
-    float dist = vectorLength(P.position - M.position);
-    bool aggro = dist < 400.f;
-    sf::Vector2f probe = M.position +
-        sf::Vector2f(std::cos(M.orientation),std::sin(M.orientation))*10.f;
-    bool wallHit = isInsideWall(probe, walls);
-
-    auto action = evaluate(tree_, room, dist, aggro, wallHit);
-    if (action=="chase") {
+    MonsterAction action = valid() ? decide(M, P, walls) : MonsterAction::Wander;
+    if (action==MonsterAction::Chase) {
         Kinematic target = P;
         return ArriveBehavior(200,200,10,400,0.2f)
                .getSteering(M,target,dt);
     }
-    if (action=="wander") {
+    if (action==MonsterAction::Wander) {
         // use your GraphWanderTask inline or call into it
         // …
     }
@@ -4,19 +4,28 @@
 #include <nlohmann/json.hpp>  // you can vendor a single‑header JSON lib
 #include "Node.hpp"
 #include "Steering.hpp"
+#include "LearnedDecisionTree.hpp"
 
 class DecisionTreeController {
 public:
+    /// Compiles the learned tree once; check valid() afterwards.
     DecisionTreeController(const nlohmann::json& tree);
+    /// Uses a tree compiled to C++ by dtgen.
+    explicit DecisionTreeController(LearnedTreeFn tree);
+
+    bool valid() const { return fn_ || !tree_.empty(); }
+    const std::string& error() const { return error_; }
+
+    MonsterAction decide(const Kinematic& monster,
+                         const Kinematic& player,
+                         const std::vector<sf::RectangleShape>& walls) const;
+
     SteeringOutput update(const Kinematic& monster,
                           const Kinematic& player,
                           const std::vector<sf::RectangleShape>& walls,
                           float dt);
 private:
-    nlohmann::json tree_;
-    std::string    evaluate(const nlohmann::json& node,
-                            int room,
-                            float dist,
-                            bool aggro,
-                            bool wallHit);
+    LearnedDecisionTree tree_;
+    LearnedTreeFn       fn_ = nullptr;
+    std::string         error_;
 };
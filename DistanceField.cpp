@@ -0,0 +1,145 @@
+// DistanceField.cpp
+#include "DistanceField.hpp"
+#include "Environment.hpp"     // for wallDistance
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ostream>
+#include <random>
+
+void DistanceField::build(const std::vector<sf::RectangleShape>& walls, float cellSize) {
+    auto t0 = std::chrono::steady_clock::now();
+    walls_ = &walls;
+    cell_  = cellSize;
+    dist_.clear();
+    cols_ = rows_ = 0;
+    if (walls.empty() || cellSize <= 0.f)
+        return;
+
+    // wall boxes the same way wallDistance reads them
+    struct Box { float l, t, r, b; };
+    std::vector<Box> boxes;
+    boxes.reserve(walls.size());
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (auto& w : walls) {
+        Box b{ w.getPosition().x, w.getPosition().y,
+               w.getPosition().x + w.getSize().x, w.getPosition().y + w.getSize().y };
+        boxes.push_back(b);
+        minX = std::min(minX, b.l); minY = std::min(minY, b.t);
+        maxX = std::max(maxX, b.r); maxY = std::max(maxY, b.b);
+    }
+    const float margin = 2.f * cell_;
+    originX_ = minX - margin;
+    originY_ = minY - margin;
+    cols_ = (int)std::ceil((maxX + margin - originX_) / cell_) + 1;
+    rows_ = (int)std::ceil((maxY + margin - originY_) / cell_) + 1;
+    dist_.assign((std::size_t)cols_ * rows_, 0.f);
+
+    // walls bucketed on a coarse grid; each vertex searches rings of
+    // buckets outward until no farther bucket can hold a closer wall
+    const float bucket = std::max(64.f, 8.f * cell_);
+    const int bx = (int)std::ceil((cols_ * cell_) / bucket) + 1;
+    const int by = (int)std::ceil((rows_ * cell_) / bucket) + 1;
+    std::vector<std::vector<int>> buckets((std::size_t)bx * by);
+    for (int i = 0; i < (int)boxes.size(); ++i) {
+        const Box& b = boxes[i];
+        int x0 = std::max(0, (int)std::floor((b.l - originX_) / bucket));
+        int x1 = std::min(bx - 1, (int)std::floor((b.r - originX_) / bucket));
+        int y0 = std::max(0, (int)std::floor((b.t - originY_) / bucket));
+        int y1 = std::min(by - 1, (int)std::floor((b.b - originY_) / bucket));
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                buckets[(std::size_t)y * bx + x].push_back(i);
+    }
+    const int maxRing = std::max(bx, by);
+
+    for (int j = 0; j < rows_; ++j) {
+        float py = originY_ + j * cell_;
+        int cy = std::min(by - 1, (int)((py - originY_) / bucket));
+        for (int i = 0; i < cols_; ++i) {
+            float px = originX_ + i * cell_;
+            int cx = std::min(bx - 1, (int)((px - originX_) / bucket));
+            float best = INFINITY;
+            for (int r = 0; r <= maxRing; ++r) {
+                for (int y = cy - r; y <= cy + r; ++y) {
+                    if (y < 0 || y >= by) continue;
+                    bool edgeRow = (y == cy - r || y == cy + r);
+                    for (int x = cx - r; x <= cx + r; x += (edgeRow || r == 0) ? 1 : 2 * r) {
+                        if (x < 0 || x >= bx) continue;
+                        for (int wi : buckets[(std::size_t)y * bx + x]) {
+                            const Box& b = boxes[wi];
+                            float dx = std::max({ b.l - px, px - b.r, 0.f });
+                            float dy = std::max({ b.t - py, py - b.b, 0.f });
+                            best = std::min(best, std::hypot(dx, dy));
+                        }
+                    }
+                }
+                // walls in ring r+1 and beyond are at least r buckets away
+                if (best <= r * bucket)
+                    break;
+            }
+            dist_[(std::size_t)j * cols_ + i] = best;
+        }
+    }
+    buildSeconds_ = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+float DistanceField::sample(const sf::Vector2f& pos) const {
+    float fx = (pos.x - originX_) / cell_;
+    float fy = (pos.y - originY_) / cell_;
+    int i = (int)std::floor(fx);
+    int j = (int)std::floor(fy);
+    if (i < 0 || j < 0 || i >= cols_ - 1 || j >= rows_ - 1)
+        return walls_ ? wallDistance(pos, *walls_) : INFINITY;
+
+    float tx = fx - i, ty = fy - j;
+    const float* row0 = &dist_[(std::size_t)j * cols_ + i];
+    const float* row1 = row0 + cols_;
+    float top    = row0[0] + (row0[1] - row0[0]) * tx;
+    float bottom = row1[0] + (row1[1] - row1[0]) * tx;
+    return top + (bottom - top) * ty;
+}
+
+void DistanceField::report(std::ostream& out, int samples) const {
+    if (empty()) {
+        out << "distance field: not built\n";
+        return;
+    }
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> ux(originX_, originX_ + (cols_ - 1) * cell_);
+    std::uniform_real_distribution<float> uy(originY_, originY_ + (rows_ - 1) * cell_);
+    std::vector<sf::Vector2f> pts(samples);
+    for (auto& p : pts)
+        p = { ux(rng), uy(rng) };
+
+    using clock = std::chrono::steady_clock;
+    std::vector<float> exact(samples), field(samples);
+    auto t0 = clock::now();
+    for (int i = 0; i < samples; ++i)
+        exact[i] = wallDistance(pts[i], *walls_);
+    auto t1 = clock::now();
+    for (int i = 0; i < samples; ++i)
+        field[i] = sample(pts[i]);
+    auto t2 = clock::now();
+
+    double sum = 0.0, worst = 0.0;
+    int    flips = 0;   // nearWall‐style threshold decided differently
+    for (int i = 0; i < samples; ++i) {
+        double e = std::fabs(field[i] - exact[i]);
+        sum  += e;
+        worst = std::max(worst, e);
+        if ((field[i] < 30.f) != (exact[i] < 30.f))
+            ++flips;
+    }
+    auto nsPer = [&](clock::duration d) {
+        return std::chrono::duration<double, std::nano>(d).count() / samples;
+    };
+    out << "distance field: " << cols_ << "x" << rows_ << " vertices at "
+        << cell_ << " px, " << bytes() / 1024 << " KiB, built in "
+        << buildSeconds_ * 1000.0 << " ms\n"
+        << "  error:        " << sum / samples << " px mean, " << worst << " px max, "
+        << flips << "/" << samples << " flips at 30 px\n"
+        << "  exact scan:   " << nsPer(t1 - t0) << " ns/query\n"
+        << "  field sample: " << nsPer(t2 - t1) << " ns/query\n";
+}
@@ -1,6 +1,14 @@
 // Environment.cpp
 #include "Environment.hpp"
+#include "NodeGridIndex.hpp"
+#include "NavGraph.hpp"
 #include <cmath>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+#include <utility>
 
 // define the global
 std::vector<Node> graphNodes;
@@ -14,6 +22,32 @@ bool isInsideWall(const sf::Vector2f& pos,
     return false;
 }
 
+float wallDistance(const sf::Vector2f& pos,
+                   const std::vector<sf::RectangleShape>& walls)
+{
+    float best = std::numeric_limits<float>::infinity();
+    for (auto& w : walls) {
+        // axis‐aligned distance to rectangle
+        float dx = std::max({ w.getPosition().x - pos.x,
+                              pos.x - (w.getPosition().x + w.getSize().x),
+                              0.f });
+        float dy = std::max({ w.getPosition().y - pos.y,
+                              pos.y - (w.getPosition().y + w.getSize().y),
+                              0.f });
+        best = std::min(best, std::hypot(dx, dy));
+    }
+    return best;
+}
+
+int getRoomId(const sf::Vector2f& pos) {
+    bool right = pos.x >= 320.f;
+    bool down  = pos.y >= 240.f;
+    if (!right && !down) return 0;
+    if ( right && !down) return 1;
+    if (!right &&  down) return 2;
+    return 3;
+}
+
 void drawSymmetricRoomLayout(std::vector<sf::RectangleShape>& walls) {
     sf::RectangleShape wall;
     wall.setFillColor(sf::Color(150,0,0));
@@ -39,39 +73,176 @@ void drawSymmetricRoomLayout(std::vector<sf::RectangleShape>& walls) {
     wall.setSize({72,12});  wall.setPosition({110,350}); walls.push_back(wall);
 }
 
+void drawRoomGridLayout(std::vector<sf::RectangleShape>& walls,
+                        int cols, int rows, int roomCells,
+                        int spacing, unsigned seed)
+{
+    sf::RectangleShape wall;
+    wall.setFillColor(sf::Color(150,0,0));
+    const float s = (float)spacing;
+    const float half = 6.f;   // same 12px thickness as the four‐room walls
+    std::mt19937 rng(seed);
+    auto pick = [&](int lo, int hi) {
+        return std::uniform_int_distribution<int>(lo, hi)(rng);
+    };
+    // wall over lattice points (x0..x1, y0..y1), inclusive
+    auto addWall = [&](int x0, int y0, int x1, int y1) {
+        wall.setPosition({ x0*s - half, y0*s - half });
+        wall.setSize({ (x1-x0)*s + 2*half, (y1-y0)*s + 2*half });
+        walls.push_back(wall);
+    };
+
+    // lattice line 1 is the outer left/top wall
+    int right  = 1 + cols*roomCells;
+    int bottom = 1 + rows*roomCells;
+    addWall(1, 1, right, 1);
+    addWall(1, bottom, right, bottom);
+    addWall(1, 1, 1, bottom);
+    addWall(right, 1, right, bottom);
+
+    // shared walls, each with a 2‐cell doorway
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            int x0 = 1 + c*roomCells, y0 = 1 + r*roomCells;
+            int x1 = x0 + roomCells,  y1 = y0 + roomCells;
+            if (c + 1 < cols) {
+                int door = pick(y0 + 1, y1 - 3);
+                addWall(x1, y0, x1, door - 1);
+                addWall(x1, door + 2, x1, y1);
+            }
+            if (r + 1 < rows) {
+                int door = pick(x0 + 1, x1 - 3);
+                addWall(x0, y1, door - 1, y1);
+                addWall(door + 2, y1, x1, y1);
+            }
+            // one 3‐cell bar inside the room
+            int bx = pick(x0 + 2, x1 - 4), by = pick(y0 + 2, y1 - 4);
+            if (pick(0, 1)) addWall(bx, by, bx + 2, by);
+            else            addWall(bx, by, bx, by + 2);
+        }
+    }
+}
+
 void createGraphGrid(std::vector<Node>& graph,
                      const std::vector<sf::RectangleShape>& walls,
-                     int spacing, int width, int height)
+                     int spacing, int width, int height,
+                     GraphBuildStats* stats)
 {
+    auto t0 = std::chrono::steady_clock::now();
+
     std::vector<sf::Vector2f> removePts = {
         {156,126},{156,150},{156,174},{156,198},
         {396,102},{420,102},{396,126},
         {108,366},{444,366},{468,366}
     };
 
-    for (int x = spacing; x < width; x += spacing) {
-        for (int y = spacing; y < height; y += spacing) {
-            sf::Vector2f p(x,y);
-            if (x<=60||x>=580||y<=30||y>=450) continue;
-            if (isInsideWall(p,walls)) continue;
-            bool skip=false;
-            for (auto& r : removePts)
-                if (std::hypot(p.x-r.x,p.y-r.y)<1.f) { skip=true; break; }
-            if (!skip) graph.push_back({p,{}});
+    // only keep points strictly inside the walls' bounding box (for the
+    // four‐room layout that is the old 60/580/30/450 cut, same nodes)
+    float minX = 0.f, minY = 0.f, maxX = (float)width, maxY = (float)height;
+    if (!walls.empty()) {
+        sf::FloatRect b = walls[0].getGlobalBounds();
+        minX = b.left; minY = b.top; maxX = b.left + b.width; maxY = b.top + b.height;
+        for (auto& w : walls) {
+            b = w.getGlobalBounds();
+            minX = std::min(minX, b.left);            minY = std::min(minY, b.top);
+            maxX = std::max(maxX, b.left + b.width);  maxY = std::max(maxY, b.top + b.height);
+        }
+    }
+
+    // lattice point (i, j) is (spacing*(i+1), spacing*(j+1)); cells are
+    // stored column‐major, the order nodes have always been numbered in
+    const int cols = std::max(0, (width  - 1) / spacing);
+    const int rows = std::max(0, (height - 1) / spacing);
+    const std::size_t cellCount = (std::size_t)cols * rows;
+    std::vector<uint8_t> blocked(cellCount, 0);
+    auto cellOf = [&](int i, int j) { return (std::size_t)i * rows + j; };
+    auto lattice = [&](int i) { return (float)(spacing * (i + 1)); };
+    // lattice indices whose coordinate could fall in [lo, hi]
+    auto span = [&](float lo, float hi, int count, int& first, int& last) {
+        first = std::max(0, (int)std::floor(lo / spacing) - 2);
+        last  = std::min(count - 1, (int)std::ceil(hi / spacing));
+    };
+
+    // rasterize each wall once over the lattice points it can cover
+    for (auto& w : walls) {
+        sf::FloatRect b = w.getGlobalBounds();
+        int i0, i1, j0, j1;
+        span(std::min(b.left, b.left + b.width), std::max(b.left, b.left + b.width), cols, i0, i1);
+        span(std::min(b.top, b.top + b.height),  std::max(b.top, b.top + b.height),  rows, j0, j1);
+        for (int i = i0; i <= i1; ++i)
+            for (int j = j0; j <= j1; ++j)
+                if (b.contains(sf::Vector2f(lattice(i), lattice(j))))
+                    blocked[cellOf(i, j)] = 1;
+    }
+
+    // removed points knock out lattice points within 1px
+    for (auto& r : removePts) {
+        int i0, i1, j0, j1;
+        span(r.x - 1.f, r.x + 1.f, cols, i0, i1);
+        span(r.y - 1.f, r.y + 1.f, rows, j0, j1);
+        for (int i = i0; i <= i1; ++i)
+            for (int j = j0; j <= j1; ++j)
+                if (std::hypot(lattice(i) - r.x, lattice(j) - r.y) < 1.f)
+                    blocked[cellOf(i, j)] = 1;
+    }
+
+    // number the surviving points
+    const int base = (int)graph.size();
+    std::vector<int> nodeAt(cellCount, -1);
+    for (int i = 0; i < cols; ++i) {
+        float x = lattice(i);
+        if (x <= minX || x >= maxX) continue;
+        for (int j = 0; j < rows; ++j) {
+            float y = lattice(j);
+            if (y <= minY || y >= maxY || blocked[cellOf(i, j)]) continue;
+            nodeAt[cellOf(i, j)] = (int)graph.size();
+            graph.push_back({ sf::Vector2f(x, y), {} });
         }
     }
 
-    // connect neighbors
-    for (int i = 0; i < (int)graph.size(); ++i) {
-        for (int j = i+1; j < (int)graph.size(); ++j) {
-            float d = std::hypot(
-                graph[i].position.x-graph[j].position.x,
-                graph[i].position.y-graph[j].position.y
-            );
-            if (d <= spacing+2) {
-                graph[i].neighbors.push_back(j);
-                graph[j].neighbors.push_back(i);
+    // link through lattice offsets within spacing+2 (just the 4‐neighbors
+    // unless spacing is tiny); column‐major offset order keeps every
+    // neighbor list ascending, as the old all‐pairs loop produced
+    std::vector<std::pair<int,int>> offsets;
+    const int reach = (spacing + 2) / spacing;
+    for (int di = -reach; di <= reach; ++di)
+        for (int dj = -reach; dj <= reach; ++dj)
+            if ((di || dj) &&
+                std::hypot((float)(di * spacing), (float)(dj * spacing)) <= spacing + 2)
+                offsets.push_back({ di, dj });
+
+    std::size_t edges = 0;
+    for (int i = 0; i < cols; ++i) {
+        for (int j = 0; j < rows; ++j) {
+            int u = nodeAt[cellOf(i, j)];
+            if (u < 0) continue;
+            auto& nb = graph[u].neighbors;
+            nb.reserve(offsets.size());
+            for (auto& o : offsets) {
+                int ni = i + o.first, nj = j + o.second;
+                if (ni < 0 || nj < 0 || ni >= cols || nj >= rows) continue;
+                int v = nodeAt[cellOf(ni, nj)];
+                if (v >= 0) nb.push_back(v);
             }
+            nb.shrink_to_fit();
+            edges += nb.size();
         }
     }
+
+    // nearest‐node lookups go through the lattice index, searches through
+    // the CSR copy
+    graphIndex.build(graph, (float)spacing);
+    navGraph.build(graph);
+
+    if (stats) {
+        stats->seconds      = std::chrono::duration<double>(
+                                  std::chrono::steady_clock::now() - t0).count();
+        stats->cells        = cellCount;
+        stats->nodes        = graph.size() - base;
+        stats->edges        = edges / 2;
+        stats->graphBytes   = NavGraph::nodeVectorBytes(graph);
+        stats->csrBytes     = navGraph.bytes();
+        stats->scratchBytes = blocked.capacity() * sizeof(uint8_t)
+                            + nodeAt.capacity() * sizeof(int);
+    }
 }
@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <cstddef>
 #include "Node.hpp"
 
 // global nav‐mesh storage (instantiate in Environment.cpp)
@@ -10,8 +11,38 @@ extern std::vector<Node> graphNodes;
 
 // build & probe the four‐room layout
 void drawSymmetricRoomLayout(std::vector<sf::RectangleShape>& walls);
+// bigger generated maps: cols×rows rooms of roomCells×roomCells lattice
+// cells, one doorway per shared wall and one short bar per room, all
+// placed from `seed`. Walls are centred on lattice lines so they always
+// remove nodes. roomCells must be at least 6; pass width = (cols*roomCells+2)*spacing (same for height)
+// to createGraphGrid.
+void drawRoomGridLayout(std::vector<sf::RectangleShape>& walls,
+                        int cols, int rows, int roomCells,
+                        int spacing, unsigned seed);
+
+/// Startup cost of one createGraphGrid call.
+struct GraphBuildStats {
+    double      seconds      = 0.0;
+    std::size_t cells        = 0;   // lattice points considered
+    std::size_t nodes        = 0;
+    std::size_t edges        = 0;   // undirected
+    std::size_t graphBytes   = 0;   // the Node vector
+    std::size_t csrBytes     = 0;   // navGraph
+    std::size_t scratchBytes = 0;   // occupancy + cell→node tables, freed on return
+};
+
+// lattice nodes every `spacing` px, linked within spacing+2; O(cells + wall
+// area), walls are rasterized once
 void createGraphGrid(std::vector<Node>& graphNodes,
                      const std::vector<sf::RectangleShape>& walls,
-                     int spacing, int width, int height);
+                     int spacing, int width, int height,
+                     GraphBuildStats* stats = nullptr);
 bool isInsideWall(const sf::Vector2f& pos,
                   const std::vector<sf::RectangleShape>& walls);
+// exact distance to the nearest wall rectangle (0 inside one); O(walls),
+// see DistanceField for the per‐frame version
+float wallDistance(const sf::Vector2f& pos,
+                   const std::vector<sf::RectangleShape>& walls);
+
+// which of the 4 rooms am I in? (0 = top‐left … 3 = bottom‐right)
+int getRoomId(const sf::Vector2f& pos);
@@ -0,0 +1,98 @@
+// FlatBehaviorTree.cpp
+#include "FlatBehaviorTree.hpp"
+#include <cassert>
+
+int FlatBehaviorTree::add(Type type, std::initializer_list<int> children,
+                          float a, float b)
+{
+    for (int c : children)
+        assert(c >= 0 && c < (int)nodes_.size() && "children must be added first");
+    if (type >= Type::Chase) {
+        uint8_t bit = uint8_t(1u << int(type));
+        assert(!(leaves_ & bit) && "each task kind may appear once");
+        leaves_ |= bit;
+    }
+
+    Node n;
+    n.type       = type;
+    n.slot       = 0;
+    n.childCount = (uint16_t)children.size();
+    n.firstChild = (uint32_t)children_.size();
+    n.a          = a;
+    n.b          = b;
+    for (int c : children)
+        children_.push_back((uint16_t)c);
+    nodes_.push_back(n);
+    root_ = (int)nodes_.size() - 1;
+    return root_;
+}
+
+int FlatBehaviorTree::selector(std::initializer_list<int> children) {
+    return add(Type::Selector, children);
+}
+
+int FlatBehaviorTree::sequence(std::initializer_list<int> children) {
+    return add(Type::Sequence, children);
+}
+
+int FlatBehaviorTree::randomSelector(std::initializer_list<int> children) {
+    assert(randomSelectors_ < MonsterBlackboard::kRandomSelectors);
+    int i = add(Type::RandomSelector, children);
+    nodes_[i].slot = (uint8_t)randomSelectors_++;
+    return i;
+}
+
+int FlatBehaviorTree::chase(float aggroRange, float pathRange) {
+    return add(Type::Chase, {}, aggroRange, pathRange);
+}
+
+int FlatBehaviorTree::reset() {
+    return add(Type::Reset, {});
+}
+
+int FlatBehaviorTree::wander() {
+    return add(Type::Wander, {});
+}
+
+Status FlatBehaviorTree::tick(MonsterBlackboard& bb, WorldState& w, float dt) const {
+    return tickNode(root_, bb, w, dt);
+}
+
+Status FlatBehaviorTree::tickNode(int i, MonsterBlackboard& bb,
+                                  WorldState& w, float dt) const
+{
+    const Node&     n     = nodes_[i];
+    const uint16_t* child = children_.data() + n.firstChild;
+    switch (n.type) {
+        case Type::Selector:
+            for (int k = 0; k < n.childCount; ++k) {
+                Status s = tickNode(child[k], bb, w, dt);
+                if (s != Status::Failure)
+                    return s;
+            }
+            return Status::Failure;
+        case Type::Sequence:
+            for (int k = 0; k < n.childCount; ++k) {
+                Status s = tickNode(child[k], bb, w, dt);
+                if (s != Status::Success)
+                    return s;
+            }
+            return Status::Success;
+        case Type::RandomSelector: {
+            int8_t& choice = bb.randomChoice[n.slot];
+            if (choice < 0)
+                choice = (int8_t)w.rng.below(n.childCount);
+            Status s = tickNode(child[choice], bb, w, dt);
+            if (s != Status::Running)
+                choice = -1;
+            return s;
+        }
+        case Type::Chase:
+            return tickChase(bb.chase, w, dt, n.a, n.b);
+        case Type::Reset:
+            return tickReset(bb.reset, w);
+        case Type::Wander:
+            return tickWander(bb.wander, w, dt);
+    }
+    return Status::Failure;
+}
@@ -0,0 +1,71 @@
+// FlatBehaviorTree.hpp
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <initializer_list>
+#include "BTNode.hpp"
+#include "MonsterTasks.hpp"
+
+/// Everything one monster remembers between ticks of a FlatBehaviorTree:
+/// one state block per task kind, plus the child each random selector is
+/// committed to. Lives inside the agent (no allocation of its own), so a
+/// tree can be shared by any number of monsters.
+struct MonsterBlackboard {
+    static const int kRandomSelectors = 4;
+
+    ChaseState  chase;
+    WanderState wander;
+    ResetState  reset;
+    int8_t      randomChoice[kRandomSelectors] = { -1, -1, -1, -1 };   // -1 = none yet
+};
+
+/// Behavior tree as one immutable array of nodes linked by index, ticked
+/// by a switch instead of virtual calls. Composites have the same semantics
+/// as SelectorNode / SequenceNode / RandomSelectorNode; leaves run the
+/// tickChase / tickReset / tickWander functions on the agent's blackboard.
+///
+/// Build children before their parent; the last node added is the root
+/// unless setRoot() says otherwise. Each leaf kind may appear once (its
+/// state is a single blackboard block), and there may be up to
+/// MonsterBlackboard::kRandomSelectors random selectors.
+class FlatBehaviorTree {
+public:
+    enum class Type : uint8_t { Selector, Sequence, RandomSelector, Chase, Reset, Wander };
+
+    struct Node {
+        Type     type;
+        uint8_t  slot;          // random selector: its blackboard choice
+        uint16_t childCount;
+        uint32_t firstChild;    // into children_
+        float    a, b;          // Chase: aggroRange, pathRange
+    };
+
+    int selector(std::initializer_list<int> children);
+    int sequence(std::initializer_list<int> children);
+    int randomSelector(std::initializer_list<int> children);
+    int chase(float aggroRange = 600.f, float pathRange = 150.f);
+    int reset();
+    int wander();
+
+    void setRoot(int node) { root_ = node; }
+    int  root() const      { return root_; }
+
+    Status tick(MonsterBlackboard& bb, WorldState& w, float dt) const;
+
+    std::size_t size()  const { return nodes_.size(); }
+    std::size_t bytes() const {
+        return nodes_.size() * sizeof(Node) + children_.size() * sizeof(uint16_t);
+    }
+
+private:
+    std::vector<Node>     nodes_;
+    std::vector<uint16_t> children_;
+    int                   root_           = -1;
+    int                   randomSelectors_ = 0;
+    uint8_t               leaves_          = 0;    // bit per leaf Type already used
+
+    int    add(Type type, std::initializer_list<int> children, float a = 0.f, float b = 0.f);
+    Status tickNode(int i, MonsterBlackboard& bb, WorldState& w, float dt) const;
+};
@@ -0,0 +1,187 @@
+// FlockKernel.cpp
+#include "FlockKernel.hpp"
+#include <cmath>
+
+#if FLOCK_KERNEL_X86
+#include <immintrin.h>
+
+// the AVX2 path is compiled for AVX2 even when the rest of the build isn't,
+// so it must only run where flockKernelHasAVX2() says so
+#if defined(__AVX2__)
+#define FLOCK_AVX2
+#else
+#define FLOCK_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+// scalar tail shared by all paths: candidates [from, n)
+static void accumulateTail(const float* px, const float* py,
+                           const float* vx, const float* vy, int from, int n,
+                           float cx, float cy,
+                           float neighborRadius, float separationRadius,
+                           FlockSums& s)
+{
+    for (int i = from; i < n; ++i) {
+        float dx = px[i] - cx;
+        float dy = py[i] - cy;
+        float distance = std::sqrt(dx*dx + dy*dy);
+        if (distance < neighborRadius && distance > 0.f) {
+            s.alignmentX += vx[i];
+            s.alignmentY += vy[i];
+            s.cohesionX  += px[i];
+            s.cohesionY  += py[i];
+            s.count++;
+            if (distance < separationRadius) {
+                s.separationX -= dx / distance;
+                s.separationY -= dy / distance;
+            }
+        }
+    }
+}
+
+FlockSums accumulateFlockScalar(const float* px, const float* py,
+                                const float* vx, const float* vy, int n,
+                                float cx, float cy,
+                                float neighborRadius, float separationRadius)
+{
+    FlockSums s;
+    accumulateTail(px, py, vx, vy, 0, n, cx, cy,
+                   neighborRadius, separationRadius, s);
+    return s;
+}
+
+#if FLOCK_KERNEL_X86
+
+bool flockKernelHasAVX2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+FLOCK_AVX2 static float hsum(__m256 v) {
+    __m128 lo = _mm256_castps256_ps128(v);
+    __m128 hi = _mm256_extractf128_ps(v, 1);
+    lo = _mm_add_ps(lo, hi);
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+    return _mm_cvtss_f32(lo);
+}
+
+FLOCK_AVX2 FlockSums accumulateFlockAVX2(const float* px, const float* py,
+                                         const float* vx, const float* vy, int n,
+                                         float cx, float cy,
+                                         float neighborRadius, float separationRadius)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 vcx  = _mm256_set1_ps(cx);
+    const __m256 vcy  = _mm256_set1_ps(cy);
+    const __m256 nr   = _mm256_set1_ps(neighborRadius);
+    const __m256 sr   = _mm256_set1_ps(separationRadius);
+
+    __m256 sepX = zero, sepY = zero, aliX = zero, aliY = zero,
+           cohX = zero, cohY = zero;
+    int count = 0;
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 ox = _mm256_loadu_ps(px + i);
+        __m256 oy = _mm256_loadu_ps(py + i);
+        __m256 dx = _mm256_sub_ps(ox, vcx);
+        __m256 dy = _mm256_sub_ps(oy, vcy);
+        __m256 dist = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx),
+                                                   _mm256_mul_ps(dy, dy)));
+        __m256 inN = _mm256_and_ps(_mm256_cmp_ps(dist, nr, _CMP_LT_OQ),
+                                   _mm256_cmp_ps(dist, zero, _CMP_GT_OQ));
+        __m256 inS = _mm256_and_ps(inN, _mm256_cmp_ps(dist, sr, _CMP_LT_OQ));
+
+        aliX = _mm256_add_ps(aliX, _mm256_and_ps(inN, _mm256_loadu_ps(vx + i)));
+        aliY = _mm256_add_ps(aliY, _mm256_and_ps(inN, _mm256_loadu_ps(vy + i)));
+        cohX = _mm256_add_ps(cohX, _mm256_and_ps(inN, ox));
+        cohY = _mm256_add_ps(cohY, _mm256_and_ps(inN, oy));
+        // masked‐off lanes may divide by zero; the mask drops them
+        sepX = _mm256_sub_ps(sepX, _mm256_and_ps(inS, _mm256_div_ps(dx, dist)));
+        sepY = _mm256_sub_ps(sepY, _mm256_and_ps(inS, _mm256_div_ps(dy, dist)));
+        count += __builtin_popcount(_mm256_movemask_ps(inN));
+    }
+
+    FlockSums s;
+    s.separationX = hsum(sepX); s.separationY = hsum(sepY);
+    s.alignmentX  = hsum(aliX); s.alignmentY  = hsum(aliY);
+    s.cohesionX   = hsum(cohX); s.cohesionY   = hsum(cohY);
+    s.count       = count;
+    accumulateTail(px, py, vx, vy, i, n, cx, cy,
+                   neighborRadius, separationRadius, s);
+    return s;
+}
+
+static float hsum(__m128 v) {
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+FlockSums accumulateFlockSSE2(const float* px, const float* py,
+                              const float* vx, const float* vy, int n,
+                              float cx, float cy,
+                              float neighborRadius, float separationRadius)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 vcx  = _mm_set1_ps(cx);
+    const __m128 vcy  = _mm_set1_ps(cy);
+    const __m128 nr   = _mm_set1_ps(neighborRadius);
+    const __m128 sr   = _mm_set1_ps(separationRadius);
+
+    __m128 sepX = zero, sepY = zero, aliX = zero, aliY = zero,
+           cohX = zero, cohY = zero;
+    int count = 0;
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 ox = _mm_loadu_ps(px + i);
+        __m128 oy = _mm_loadu_ps(py + i);
+        __m128 dx = _mm_sub_ps(ox, vcx);
+        __m128 dy = _mm_sub_ps(oy, vcy);
+        __m128 dist = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx),
+                                             _mm_mul_ps(dy, dy)));
+        __m128 inN = _mm_and_ps(_mm_cmplt_ps(dist, nr),
+                                _mm_cmpgt_ps(dist, zero));
+        __m128 inS = _mm_and_ps(inN, _mm_cmplt_ps(dist, sr));
+
+        aliX = _mm_add_ps(aliX, _mm_and_ps(inN, _mm_loadu_ps(vx + i)));
+        aliY = _mm_add_ps(aliY, _mm_and_ps(inN, _mm_loadu_ps(vy + i)));
+        cohX = _mm_add_ps(cohX, _mm_and_ps(inN, ox));
+        cohY = _mm_add_ps(cohY, _mm_and_ps(inN, oy));
+        // masked‐off lanes may divide by zero; the mask drops them
+        sepX = _mm_sub_ps(sepX, _mm_and_ps(inS, _mm_div_ps(dx, dist)));
+        sepY = _mm_sub_ps(sepY, _mm_and_ps(inS, _mm_div_ps(dy, dist)));
+        count += __builtin_popcount(_mm_movemask_ps(inN));
+    }
+
+    FlockSums s;
+    s.separationX = hsum(sepX); s.separationY = hsum(sepY);
+    s.alignmentX  = hsum(aliX); s.alignmentY  = hsum(aliY);
+    s.cohesionX   = hsum(cohX); s.cohesionY   = hsum(cohY);
+    s.count       = count;
+    accumulateTail(px, py, vx, vy, i, n, cx, cy,
+                   neighborRadius, separationRadius, s);
+    return s;
+}
+
+#endif
+
+// the path the build targets; no runtime dispatch, so a SIMDFLAGS=-mavx2
+// build is exactly as portable as before
+FlockSums accumulateFlock(const float* px, const float* py,
+                          const float* vx, const float* vy, int n,
+                          float cx, float cy,
+                          float neighborRadius, float separationRadius)
+{
+#if defined(__AVX2__)
+    return accumulateFlockAVX2(px, py, vx, vy, n, cx, cy,
+                               neighborRadius, separationRadius);
+#elif FLOCK_KERNEL_X86 && defined(__SSE2__)
+    return accumulateFlockSSE2(px, py, vx, vy, n, cx, cy,
+                               neighborRadius, separationRadius);
+#else
+    return accumulateFlockScalar(px, py, vx, vy, n, cx, cy,
+                                 neighborRadius, separationRadius);
+#endif
+}
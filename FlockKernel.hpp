@@ -0,0 +1,45 @@
+// FlockKernel.hpp
+#pragma once
+
+/// Running sums FlockingBehavior needs from its neighbors.
+struct FlockSums {
+    float separationX = 0.f, separationY = 0.f;  // Σ (self - other) / distance, inside separationRadius
+    float alignmentX  = 0.f, alignmentY  = 0.f;  // Σ other velocity
+    float cohesionX   = 0.f, cohesionY   = 0.f;  // Σ other position
+    int   count       = 0;                       // neighbors inside neighborRadius
+};
+
+/// Accumulates separation/alignment/cohesion over n candidate neighbors given
+/// as SoA arrays, around the boid at (cx, cy). Same rules as the scalar
+/// FlockingBehavior loop: a candidate counts if 0 < distance < neighborRadius
+/// and adds to separation if distance < separationRadius.
+///
+/// Uses AVX2 (8 lanes) or SSE2 (4 lanes) when the compiler targets them,
+/// otherwise the scalar version below.
+FlockSums accumulateFlock(const float* px, const float* py,
+                          const float* vx, const float* vy, int n,
+                          float cx, float cy,
+                          float neighborRadius, float separationRadius);
+
+/// Plain scalar reference of accumulateFlock.
+FlockSums accumulateFlockScalar(const float* px, const float* py,
+                                const float* vx, const float* vy, int n,
+                                float cx, float cy,
+                                float neighborRadius, float separationRadius);
+
+#if defined(__x86_64__)
+#define FLOCK_KERNEL_X86 1
+
+/// The two SIMD paths by name, built on every x86 target whatever
+/// SIMDFLAGS says, so flockcheck can hold each one against the scalar
+/// version. accumulateFlockAVX2 needs flockKernelHasAVX2().
+FlockSums accumulateFlockSSE2(const float* px, const float* py,
+                              const float* vx, const float* vy, int n,
+                              float cx, float cy,
+                              float neighborRadius, float separationRadius);
+FlockSums accumulateFlockAVX2(const float* px, const float* py,
+                              const float* vx, const float* vy, int n,
+                              float cx, float cy,
+                              float neighborRadius, float separationRadius);
+bool      flockKernelHasAVX2();
+#endif
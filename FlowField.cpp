@@ -0,0 +1,66 @@
+// FlowField.cpp
+#include "FlowField.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+void FlowField::build(int targetIdx) {
+    std::size_t n = (std::size_t)navGraph.size();
+    target_ = targetIdx;
+    next_.assign(n, -1);
+    dist_.assign(n, std::numeric_limits<float>::infinity());
+    heap_.clear();
+    auto heapCmp = std::greater<std::pair<float,int>>();
+
+    // edges are undirected: the node we relax v from is v's next hop
+    dist_[targetIdx] = 0.f;
+    next_[targetIdx] = targetIdx;
+    heap_.push_back({ 0.f, targetIdx });
+    while (!heap_.empty()) {
+        std::pop_heap(heap_.begin(), heap_.end(), heapCmp);
+        auto [d, u] = heap_.back();
+        heap_.pop_back();
+        if (d > dist_[u])
+            continue;
+        for (int e = navGraph.edgeBegin(u), end = navGraph.edgeEnd(u); e < end; ++e) {
+            int   v  = navGraph.edgeTarget(e);
+            float nd = d + navGraph.edgeCost(e);
+            if (nd < dist_[v]) {
+                dist_[v] = nd;
+                next_[v] = u;
+                heap_.push_back({ nd, v });
+                std::push_heap(heap_.begin(), heap_.end(), heapCmp);
+            }
+        }
+    }
+}
+
+bool FlowField::route(int from, std::vector<int>& path) const {
+    path.clear();
+    if (next_[from] < 0)
+        return false;
+    path.push_back(from);
+    for (int at = from; at != target_; ) {
+        at = next_[at];
+        path.push_back(at);
+    }
+    return true;
+}
+
+const FlowField& FlowFieldService::towards(const Kinematic& target) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FlowField* field = nullptr;
+    for (auto& f : fields_)
+        if (f.first == &target) { field = &f.second; break; }
+    if (!field) {
+        fields_.push_back({ &target, FlowField() });
+        field = &fields_.back().second;
+    }
+
+    int node = getClosestNode(target.position);
+    if (node != field->target()) {
+        field->build(node);
+        ++rebuilds_;
+    }
+    return *field;
+}
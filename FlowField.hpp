@@ -0,0 +1,52 @@
+// FlowField.hpp
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include "NavGraph.hpp"
+#include "Steering.hpp"     // for Kinematic
+
+/// Best next node toward one target node, for every node of navGraph.
+/// Built with a single reverse Dijkstra from the target, so any number of
+/// chasers can read their next waypoint in O(1).
+class FlowField {
+public:
+    void build(int targetIdx);
+
+    int target() const { return target_; }
+
+    /// Next node from `from` toward the target (the target itself if
+    /// from == target), or -1 if unreachable.
+    int nextHop(int from) const { return next_[from]; }
+
+    /// Writes from..target into path; false if unreachable.
+    bool route(int from, std::vector<int>& path) const;
+
+private:
+    int                 target_ = -1;
+    std::vector<int>    next_;
+    std::vector<float>  dist_;
+    std::vector<std::pair<float,int>> heap_;
+};
+
+/// One flow field per chased kinematic (usually the player), rebuilt only
+/// when the target's closest node changes. Fields are keyed by the
+/// kinematic's address, so every chaser must pass the same object.
+///
+/// towards() may be called from several threads as long as no target moves
+/// while they do (stepMonsterAgents keeps the player still for its whole
+/// tick): the first caller rebuilds under the lock, the rest find the field
+/// current and only read it.
+class FlowFieldService {
+public:
+    const FlowField& towards(const Kinematic& target);
+
+    int rebuilds() const { return rebuilds_; }   // for profiling
+
+private:
+    std::mutex mutex_;
+    std::deque<std::pair<const Kinematic*, FlowField>> fields_;   // deque: references stay valid
+    int rebuilds_ = 0;
+};
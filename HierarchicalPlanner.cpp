@@ -0,0 +1,320 @@
+// HierarchicalPlanner.cpp
+#include "HierarchicalPlanner.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <iterator>
+#include <numeric>
+#include <unordered_map>
+
+static float nodeDistance(const sf::Vector2f& a, const sf::Vector2f& b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return std::sqrt(dx*dx + dy*dy);
+}
+
+static bool linkedOrSame(const std::vector<Node>& nodes, int a, int b) {
+    if (a == b)
+        return true;
+    const auto& nb = nodes[a].neighbors;
+    return std::find(nb.begin(), nb.end(), b) != nb.end();
+}
+
+static int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i)
+        i = parent[i] = parent[parent[i]];
+    return i;
+}
+
+HierarchicalPlanner::RegionFn blockRegions(float blockSize, sf::Vector2f origin) {
+    return [blockSize, origin](const sf::Vector2f& p) {
+        int bx = (int)std::floor((p.x - origin.x) / blockSize);
+        int by = (int)std::floor((p.y - origin.y) / blockSize);
+        return by * 65536 + bx;
+    };
+}
+
+int HierarchicalPlanner::abstractId(int node) {
+    if (abstractOf_[node] < 0) {
+        abstractOf_[node] = (int)abstractNode_.size();
+        abstractNode_.push_back(node);
+        abstractAdj_.emplace_back();
+        regionEntrances_[regionOf_[node]].push_back(abstractOf_[node]);
+    }
+    return abstractOf_[node];
+}
+
+void HierarchicalPlanner::addAbstractEdge(int a, int b, float cost) {
+    abstractAdj_[a].push_back({ b, cost });
+    abstractAdj_[b].push_back({ a, cost });
+    ++abstractEdgeCount_;
+}
+
+void HierarchicalPlanner::build(const std::vector<Node>& nodes, const RegionFn& region) {
+    auto t0 = std::chrono::steady_clock::now();
+    nodes_ = &nodes;
+    int n = (int)nodes.size();
+
+    // 1) compact region ids
+    std::unordered_map<int,int> compact;
+    regionOf_.resize(n);
+    for (int i = 0; i < n; ++i) {
+        auto it = compact.emplace(region(nodes[i].position), (int)compact.size()).first;
+        regionOf_[i] = it->second;
+    }
+    regionCount_ = (int)compact.size();
+
+    abstractNode_.clear();
+    abstractAdj_.clear();
+    abstractOf_.assign(n, -1);
+    regionEntrances_.assign(regionCount_, {});
+    adjacentRegions_.assign(regionCount_, {});
+    inSearch_.assign(regionCount_, 0);
+    abstractEdgeCount_ = 0;
+
+    g_.resize(n);
+    parent_.resize(n);
+    stamp_.assign(n, 0);
+    closed_.assign(n, 0);
+    generation_ = 0;
+
+    // 2) crossing edges per region pair, oriented low region → high region
+    std::map<std::pair<int,int>, std::vector<std::pair<int,int>>> crossings;
+    for (int u = 0; u < n; ++u)
+        for (int v : nodes[u].neighbors) {
+            int ru = regionOf_[u], rv = regionOf_[v];
+            if (ru < rv)
+                crossings[{ ru, rv }].push_back({ u, v });
+        }
+
+    // 3) runs of side‐by‐side crossing edges → one entrance at the middle edge
+    for (auto& entry : crossings) {
+        // map keys are ordered, so each neighbor list comes out sorted
+        adjacentRegions_[entry.first.first].push_back(entry.first.second);
+        adjacentRegions_[entry.first.second].push_back(entry.first.first);
+        auto& edges = entry.second;
+        std::vector<int> parent(edges.size());
+        std::iota(parent.begin(), parent.end(), 0);
+        for (std::size_t i = 0; i < edges.size(); ++i)
+            for (std::size_t j = i + 1; j < edges.size(); ++j)
+                if (linkedOrSame(nodes, edges[i].first,  edges[j].first) &&
+                    linkedOrSame(nodes, edges[i].second, edges[j].second))
+                    parent[findRoot(parent, (int)i)] = findRoot(parent, (int)j);
+
+        std::map<int, std::vector<std::pair<int,int>>> runs;
+        for (std::size_t i = 0; i < edges.size(); ++i)
+            runs[findRoot(parent, (int)i)].push_back(edges[i]);
+        for (auto& r : runs) {
+            auto& run = r.second;
+            std::sort(run.begin(), run.end(), [&](auto& a, auto& b) {
+                const sf::Vector2f& pa = nodes[a.first].position;
+                const sf::Vector2f& pb = nodes[b.first].position;
+                return pa.x < pb.x || (pa.x == pb.x && pa.y < pb.y);
+            });
+            auto [u, v] = run[run.size() / 2];
+            addAbstractEdge(abstractId(u), abstractId(v),
+                            nodeDistance(nodes[u].position, nodes[v].position));
+        }
+    }
+
+    // 4) entrance‐to‐entrance costs inside each region
+    for (int r = 0; r < regionCount_; ++r) {
+        const auto& ents = regionEntrances_[r];
+        for (std::size_t i = 0; i < ents.size(); ++i) {
+            regionSearch(abstractNode_[ents[i]], -1);
+            for (std::size_t j = i + 1; j < ents.size(); ++j) {
+                float c = gScore(abstractNode_[ents[j]]);
+                if (c < INFINITY)
+                    addAbstractEdge(ents[i], ents[j], c);
+            }
+        }
+    }
+
+    buildSeconds_ = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+}
+
+void HierarchicalPlanner::beginSearch() {
+    if (++generation_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        std::fill(closed_.begin(), closed_.end(), 0);
+        generation_ = 1;
+    }
+    open_.clear();
+}
+
+bool HierarchicalPlanner::regionSearch(int from, int goal, bool wider) {
+    const std::vector<Node>& nodes = *nodes_;
+    const int region = regionOf_[from];
+    auto heapCmp = std::greater<std::pair<float,int>>();
+    auto h = [&](int i) {
+        return goal < 0 ? 0.f : nodeDistance(nodes[i].position, nodes[goal].position);
+    };
+
+    beginSearch();
+    g_[from]      = 0.f;
+    parent_[from] = -1;
+    stamp_[from]  = generation_;
+    open_.push_back({ h(from), from });
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), heapCmp);
+        int u = open_.back().second;
+        open_.pop_back();
+        if (closed_[u] == generation_)
+            continue;
+        closed_[u] = generation_;
+        ++expanded_;
+        if (u == goal)
+            return true;
+        for (int v : nodes[u].neighbors) {
+            if (regionOf_[v] != region && !(wider && inSearch_[regionOf_[v]]))
+                continue;
+            float tentative = g_[u] + nodeDistance(nodes[u].position, nodes[v].position);
+            if (tentative < gScore(v)) {
+                g_[v]      = tentative;
+                parent_[v] = u;
+                stamp_[v]  = generation_;
+                open_.push_back({ tentative + h(v), v });
+                std::push_heap(open_.begin(), open_.end(), heapCmp);
+            }
+        }
+    }
+    return goal < 0;
+}
+
+bool HierarchicalPlanner::plan(int startIdx, int goalIdx, HpaRoute& route) {
+    route.clear();
+    expanded_ = 0;
+    const std::vector<Node>& nodes = *nodes_;
+    const int rs = regionOf_[startIdx], rg = regionOf_[goalIdx];
+    const int A = (int)abstractNode_.size();
+    const int virtualGoal = A;
+
+    // the path confined to the start and goal regions and every region
+    // bordering both is a candidate too (exact for short trips); keep its
+    // border crossings, they become the route's waypoints
+    near_.clear();
+    if (rg != rs) {
+        near_.push_back(rg);
+        const auto& ns = adjacentRegions_[rs];
+        const auto& ng = adjacentRegions_[rg];
+        std::set_intersection(ns.begin(), ns.end(), ng.begin(), ng.end(),
+                              std::back_inserter(near_));
+    }
+    for (int r : near_) inSearch_[r] = 1;
+    float direct = INFINITY;
+    crossings_.clear();
+    bool  found = regionSearch(startIdx, goalIdx, true);
+    for (int r : near_) inSearch_[r] = 0;
+    if (found) {
+        direct = g_[goalIdx];
+        for (int at = goalIdx; parent_[at] != -1; at = parent_[at])
+            if (regionOf_[at] != regionOf_[parent_[at]]) {
+                crossings_.push_back(at);
+                crossings_.push_back(parent_[at]);
+            }
+        std::reverse(crossings_.begin(), crossings_.end());
+    }
+
+    ag_.assign(A + 1, INFINITY);
+    aParent_.assign(A + 1, -1);
+    aClosed_.assign(A + 1, 0);
+    aGoal_.assign(A, INFINITY);
+
+    // start → entrances of its region
+    regionSearch(startIdx, -1);
+    for (int a : regionEntrances_[rs])
+        ag_[a] = gScore(abstractNode_[a]);
+
+    // entrances of the goal region → goal (edges are undirected)
+    regionSearch(goalIdx, -1);
+    for (int a : regionEntrances_[rg])
+        aGoal_[a] = gScore(abstractNode_[a]);
+
+    // A* over entrances plus a virtual goal
+    const sf::Vector2f goalPos = nodes[goalIdx].position;
+    auto h = [&](int a) {
+        return a == virtualGoal ? 0.f : nodeDistance(nodes[abstractNode_[a]].position, goalPos);
+    };
+    auto heapCmp = std::greater<std::pair<float,int>>();
+    open_.clear();
+    for (int a : regionEntrances_[rs])
+        if (ag_[a] < INFINITY)
+            open_.push_back({ ag_[a] + h(a), a });
+    std::make_heap(open_.begin(), open_.end(), heapCmp);
+
+    auto relax = [&](int from, int to, float g) {
+        if (g < ag_[to]) {
+            ag_[to]      = g;
+            aParent_[to] = from;
+            open_.push_back({ g + h(to), to });
+            std::push_heap(open_.begin(), open_.end(), heapCmp);
+        }
+    };
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), heapCmp);
+        int a = open_.back().second;
+        open_.pop_back();
+        if (aClosed_[a])
+            continue;
+        aClosed_[a] = 1;
+        ++expanded_;
+        if (a == virtualGoal)
+            break;
+        if (aGoal_[a] < INFINITY)
+            relax(a, virtualGoal, ag_[a] + aGoal_[a]);
+        for (auto& [b, c] : abstractAdj_[a])
+            relax(a, b, ag_[a] + c);
+    }
+
+    float viaEntrances = aClosed_[virtualGoal] ? ag_[virtualGoal] : INFINITY;
+    if (direct == INFINITY && viaEntrances == INFINITY)
+        return false;
+
+    route.waypoints.push_back(startIdx);
+    if (viaEntrances < direct) {
+        std::size_t first = route.waypoints.size();
+        for (int a = aParent_[virtualGoal]; a != -1; a = aParent_[a])
+            route.waypoints.push_back(abstractNode_[a]);
+        std::reverse(route.waypoints.begin() + first, route.waypoints.end());
+    } else {
+        // each leg between crossings stays in one region, so refining it
+        // is never longer than the confined path it came from
+        route.waypoints.insert(route.waypoints.end(), crossings_.begin(), crossings_.end());
+    }
+    route.waypoints.push_back(goalIdx);
+    // start/goal can themselves be entrances
+    route.waypoints.erase(std::unique(route.waypoints.begin(), route.waypoints.end()),
+                          route.waypoints.end());
+    if (route.waypoints.size() == 1)
+        route.waypoints.push_back(goalIdx);
+    return true;
+}
+
+bool HierarchicalPlanner::refineNext(HpaRoute& route, std::vector<int>& segment) {
+    segment.clear();
+    expanded_ = 0;
+    if (route.done())
+        return false;
+
+    int p = route.waypoints[route.next];
+    int q = route.waypoints[route.next + 1];
+    if (regionOf_[p] == regionOf_[q]) {
+        if (!regionSearch(p, q)) {
+            route.clear();
+            return false;
+        }
+        for (int at = q; at != -1; at = parent_[at])
+            segment.push_back(at);
+        std::reverse(segment.begin(), segment.end());
+    } else {
+        // crossing edge between two entrance nodes
+        segment.push_back(p);
+        segment.push_back(q);
+    }
+    if (route.next > 0)
+        segment.erase(segment.begin());
+    ++route.next;
+    return true;
+}
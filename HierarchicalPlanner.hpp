@@ -0,0 +1,109 @@
+// HierarchicalPlanner.hpp
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "Node.hpp"
+
+/// Abstract route from HierarchicalPlanner::plan(): start, the entrance
+/// nodes to pass through, goal. Only refined into graph nodes one leg at a
+/// time, as the agent gets there.
+struct HpaRoute {
+    std::vector<int> waypoints;
+    std::size_t      next = 0;      // leg waypoints[next] → waypoints[next+1]
+
+    bool done() const { return next + 1 >= waypoints.size(); }
+    void clear()      { waypoints.clear(); next = 0; }
+};
+
+/// HPA* over graphNodes. Nodes are grouped into regions (rooms, or blocks on
+/// generated maps); each run of edges crossing between two regions becomes
+/// one entrance, represented by its middle edge. Entrance‐to‐entrance costs
+/// inside each region are precomputed, so a query only searches the
+/// start and goal regions plus the small abstract graph, and each leg is
+/// refined with a search confined to one region.
+///
+/// Paths are near‐optimal: a route between regions passes each border at
+/// its entrance edge rather than wherever is shortest. To keep that from
+/// dominating short trips, plan() also searches directly inside the start
+/// region, the goal region and every region bordering both, and takes
+/// that path when it is shorter. Trips that stay within those regions are
+/// therefore exact; longer ones can still detour through entrance edges
+/// (pathbench reports the extra length over A*).
+///
+/// One planner can serve many agents on one thread; it keeps scratch state
+/// between calls.
+class HierarchicalPlanner {
+public:
+    using RegionFn = std::function<int(const sf::Vector2f&)>;
+
+    void build(const std::vector<Node>& nodes, const RegionFn& region);
+
+    bool covers(const std::vector<Node>& nodes) const {
+        return nodes_ == &nodes && regionOf_.size() == nodes.size();
+    }
+
+    /// Abstract route start → goal; false (route empty) if unreachable.
+    bool plan(int startIdx, int goalIdx, HpaRoute& route);
+
+    /// Refines the next leg of `route` into graph nodes (without the node
+    /// the previous leg ended on) and advances it. False once route is done.
+    bool refineNext(HpaRoute& route, std::vector<int>& segment);
+
+    int    regionCount()   const { return regionCount_; }
+    int    entranceNodes() const { return (int)abstractNode_.size(); }
+    int    abstractEdges() const { return abstractEdgeCount_; }
+    double buildSeconds()  const { return buildSeconds_; }
+
+    /// Graph plus abstract nodes expanded by the last plan()/refineNext().
+    int expanded() const { return expanded_; }
+
+private:
+    const std::vector<Node>*  nodes_ = nullptr;
+    std::vector<int>          regionOf_;       // node → compact region id
+    int                       regionCount_ = 0;
+
+    std::vector<int>          abstractNode_;   // abstract id → graph node
+    std::vector<int>          abstractOf_;     // graph node → abstract id or -1
+    std::vector<std::vector<std::pair<int,float>>> abstractAdj_;
+    std::vector<std::vector<int>> regionEntrances_;   // region → abstract ids
+    std::vector<std::vector<int>> adjacentRegions_;   // region → sorted neighbors
+    int                       abstractEdgeCount_ = 0;
+    double                    buildSeconds_ = 0.0;
+    int                       expanded_ = 0;
+
+    // region‐confined search scratch, valid iff stamp_ == generation_
+    std::vector<float>    g_;
+    std::vector<int>      parent_;
+    std::vector<uint32_t> stamp_;
+    std::vector<uint32_t> closed_;
+    std::vector<std::pair<float,int>> open_;
+    uint32_t              generation_ = 0;
+
+    // abstract search scratch (abstract ids, plus one virtual goal)
+    std::vector<float>    ag_;
+    std::vector<int>      aParent_;
+    std::vector<uint8_t>  aClosed_;
+    std::vector<float>    aGoal_;      // entrance → goal cost, goal region only
+    std::vector<int>      crossings_;  // border edges of the confined path
+    std::vector<int>      near_;       // regions of the confined search
+    std::vector<uint8_t>  inSearch_;   // region → in near_
+
+    void  beginSearch();
+    float gScore(int i) const { return stamp_[i] == generation_ ? g_[i] : INFINITY; }
+    // search from `from` inside its region, plus the regions marked in
+    // inSearch_ if `wider`; goal < 0 = Dijkstra over the region
+    bool  regionSearch(int from, int goal, bool wider = false);
+    void  addAbstractEdge(int a, int b, float cost);
+    int   abstractId(int node);
+};
+
+/// Region function for maps without rooms: square blocks of blockSize px,
+/// counted from origin.
+HierarchicalPlanner::RegionFn blockRegions(float blockSize,
+                                           sf::Vector2f origin = {0.f, 0.f});
@@ -0,0 +1,160 @@
+// IncrementalPlanner.cpp
+#include "IncrementalPlanner.hpp"
+#include <algorithm>
+#include <cmath>
+
+static float nodeDistance(const sf::Vector2f& a, const sf::Vector2f& b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return std::sqrt(dx*dx + dy*dy);
+}
+
+// heap order: smallest key on top
+bool IncrementalPlanner::entryAfter(const Entry& a, const Entry& b) {
+    return b.key < a.key;
+}
+
+float IncrementalPlanner::heuristic(int u) const {
+    return nodeDistance(navGraph.position(start_), navGraph.position(u));
+}
+
+IncrementalPlanner::Key IncrementalPlanner::calculateKey(int u) const {
+    float m = std::min(g_[u], rhs_[u]);
+    return { m + heuristic(u) + km_, m };
+}
+
+void IncrementalPlanner::push(int u) {
+    key_[u]    = calculateKey(u);
+    inOpen_[u] = 1;
+    open_.push_back({ key_[u], u });
+    std::push_heap(open_.begin(), open_.end(), entryAfter);
+}
+
+bool IncrementalPlanner::topKey(Key& k) {
+    // drop entries for nodes that left the queue or were re‐keyed since
+    while (!open_.empty()) {
+        const Entry& e = open_.front();
+        if (inOpen_[e.node] && e.key == key_[e.node]) {
+            k = e.key;
+            return true;
+        }
+        std::pop_heap(open_.begin(), open_.end(), entryAfter);
+        open_.pop_back();
+    }
+    return false;
+}
+
+void IncrementalPlanner::initialize(int startIdx, int goalIdx) {
+    std::size_t n = (std::size_t)navGraph.size();
+    g_.assign(n, INFINITY);
+    rhs_.assign(n, INFINITY);
+    key_.assign(n, { INFINITY, INFINITY });
+    inOpen_.assign(n, 0);
+    open_.clear();
+    km_    = 0.f;
+    start_ = startIdx;
+    goal_  = goalIdx;
+    rhs_[goal_] = 0.f;
+    push(goal_);
+}
+
+void IncrementalPlanner::updateVertex(int u) {
+    if (u != goal_) {
+        float best = INFINITY;
+        for (int e = navGraph.edgeBegin(u), end = navGraph.edgeEnd(u); e < end; ++e)
+            best = std::min(best, navGraph.edgeCost(e) + g_[navGraph.edgeTarget(e)]);
+        rhs_[u] = best;
+    }
+    inOpen_[u] = 0;
+    if (g_[u] != rhs_[u])
+        push(u);
+}
+
+void IncrementalPlanner::computeShortestPath() {
+    Key top;
+    while (topKey(top) &&
+           (top < calculateKey(start_) || rhs_[start_] != g_[start_])) {
+        int u = open_.front().node;
+        Key kNew = calculateKey(u);
+        if (top < kNew) {
+            // start moved since u was queued: requeue with the fresh key
+            push(u);
+            continue;
+        }
+        inOpen_[u] = 0;
+        ++expanded_;
+        if (g_[u] > rhs_[u]) {
+            g_[u] = rhs_[u];
+        } else {
+            g_[u] = INFINITY;
+            updateVertex(u);
+        }
+        for (int e = navGraph.edgeBegin(u), end = navGraph.edgeEnd(u); e < end; ++e)
+            updateVertex(navGraph.edgeTarget(e));
+        // lazy deletion can let the heap grow; rebuild it from live nodes
+        if (open_.size() > 4 * (std::size_t)navGraph.size() + 64) {
+            open_.clear();
+            for (int i = 0; i < navGraph.size(); ++i)
+                if (inOpen_[i])
+                    open_.push_back({ key_[i], i });
+            std::make_heap(open_.begin(), open_.end(), entryAfter);
+        }
+    }
+}
+
+bool IncrementalPlanner::plan(int startIdx, int goalIdx, std::vector<int>& path) {
+    path.clear();
+    expanded_ = 0;
+
+    bool fresh = goal_ < 0 || g_.size() != (std::size_t)navGraph.size();
+    if (!fresh && goalIdx != goal_) {
+        // only a one‐hop goal move is cheap to repair
+        fresh = true;
+        for (int e = navGraph.edgeBegin(goal_), end = navGraph.edgeEnd(goal_); e < end; ++e)
+            if (navGraph.edgeTarget(e) == goalIdx) { fresh = false; break; }
+    }
+
+    if (fresh) {
+        initialize(startIdx, goalIdx);
+    } else {
+        if (startIdx != start_) {
+            km_   += nodeDistance(navGraph.position(start_),
+                                  navGraph.position(startIdx));
+            start_ = startIdx;
+        }
+        if (goalIdx != goal_) {
+            int oldGoal = goal_;
+            goal_ = goalIdx;
+            rhs_[goal_] = 0.f;
+            updateVertex(goal_);
+            updateVertex(oldGoal);   // now gets its rhs from its neighbors
+        }
+    }
+    computeShortestPath();
+
+    if (g_[start_] == INFINITY)
+        return false;
+
+    // walk downhill on g from start to the goal
+    path.push_back(start_);
+    for (int at = start_, steps = 0; at != goal_; ++steps) {
+        if (steps > navGraph.size()) {
+            path.clear();
+            return false;
+        }
+        int   next = -1;
+        float best = INFINITY;
+        for (int e = navGraph.edgeBegin(at), end = navGraph.edgeEnd(at); e < end; ++e) {
+            int   v = navGraph.edgeTarget(e);
+            float c = navGraph.edgeCost(e) + g_[v];
+            if (c < best) { best = c; next = v; }
+        }
+        if (next < 0) {
+            path.clear();
+            return false;
+        }
+        at = next;
+        path.push_back(at);
+    }
+    return true;
+}
@@ -0,0 +1,51 @@
+// IncrementalPlanner.hpp
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "NavGraph.hpp"
+
+/// D* Lite over navGraph, rooted at the goal, for chasing a moving target.
+/// The search state survives between plan() calls:
+///  - a new start (the chaser moved) only bumps the key modifier km;
+///  - a goal that moved to an adjacent node is handled by swapping which
+///    node has rhs = 0 and repairing the inconsistent part of the search.
+/// Bigger jumps (teleports, resets) fall back to a fresh search.
+///
+/// Drop‐in for PathSearchContext::search. Owns O(N) state, so one per agent.
+class IncrementalPlanner {
+public:
+    /// Writes start..goal into path; false (path empty) if unreachable.
+    bool plan(int startIdx, int goalIdx, std::vector<int>& path);
+
+    /// Forget everything; the next plan() starts from scratch.
+    void reset() { goal_ = -1; }
+
+    /// Vertices expanded by the last plan() (for comparisons with A*).
+    int expanded() const { return expanded_; }
+
+private:
+    struct Key {
+        float k1, k2;
+        bool operator<(const Key& o) const  { return k1 < o.k1 || (k1 == o.k1 && k2 < o.k2); }
+        bool operator==(const Key& o) const { return k1 == o.k1 && k2 == o.k2; }
+    };
+    struct Entry { Key key; int node; };
+
+    std::vector<float>   g_, rhs_;
+    std::vector<Key>     key_;       // key a node is queued with
+    std::vector<uint8_t> inOpen_;
+    std::vector<Entry>   open_;      // min‐heap, stale entries skipped lazily
+    int   start_ = -1, goal_ = -1;
+    float km_ = 0.f;
+    int   expanded_ = 0;
+
+    static bool entryAfter(const Entry& a, const Entry& b);
+    void  initialize(int startIdx, int goalIdx);
+    Key   calculateKey(int u) const;
+    void  updateVertex(int u);
+    void  push(int u);
+    bool  topKey(Key& k);
+    void  computeShortestPath();
+    float heuristic(int u) const;
+};
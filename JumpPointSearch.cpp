@@ -0,0 +1,188 @@
+// JumpPointSearch.cpp
+#include "JumpPointSearch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+bool JumpPointSearch::build(const std::vector<Node>& nodes, float spacing) {
+    nodes_ = &nodes;
+    count_ = nodes.size();
+    cells_.clear();
+    nodeCell_.clear();
+    if (nodes.empty() || spacing <= 0.f)
+        return false;
+
+    float minX = nodes[0].position.x, maxX = minX;
+    float minY = nodes[0].position.y, maxY = minY;
+    for (auto& n : nodes) {
+        minX = std::min(minX, n.position.x); maxX = std::max(maxX, n.position.x);
+        minY = std::min(minY, n.position.y); maxY = std::max(maxY, n.position.y);
+    }
+    int cols = (int)std::lround((maxX - minX) / spacing) + 1;
+    int rows = (int)std::lround((maxY - minY) / spacing) + 1;
+
+    std::vector<int> cells((std::size_t)cols * rows, -1);
+    std::vector<int> nodeCell(nodes.size());
+    const float tolerance = 1e-3f * spacing;
+    for (int i = 0; i < (int)nodes.size(); ++i) {
+        float fx = (nodes[i].position.x - minX) / spacing;
+        float fy = (nodes[i].position.y - minY) / spacing;
+        int cx = (int)std::lround(fx);
+        int cy = (int)std::lround(fy);
+        int cell = cy * cols + cx;
+        if (std::abs(fx - cx) * spacing > tolerance ||
+            std::abs(fy - cy) * spacing > tolerance || cells[cell] != -1)
+            return false;
+        cells[cell] = i;
+        nodeCell[i] = cell;
+    }
+
+    // the jumps assume links == free 4‐neighbors; refuse anything else
+    for (int i = 0; i < (int)nodes.size(); ++i) {
+        int cx = nodeCell[i] % cols, cy = nodeCell[i] / cols;
+        int lattice = 0;
+        const int dx[4] = { -1, 1, 0, 0 }, dy[4] = { 0, 0, -1, 1 };
+        for (int d = 0; d < 4; ++d) {
+            int x = cx + dx[d], y = cy + dy[d];
+            if (x >= 0 && y >= 0 && x < cols && y < rows && cells[y * cols + x] >= 0)
+                ++lattice;
+        }
+        if ((int)nodes[i].neighbors.size() != lattice)
+            return false;
+        for (int nb : nodes[i].neighbors) {
+            int d = std::abs(nodeCell[nb] % cols - cx) + std::abs(nodeCell[nb] / cols - cy);
+            if (d != 1)
+                return false;
+        }
+    }
+
+    cols_ = cols;
+    rows_ = rows;
+    cells_.swap(cells);
+    nodeCell_.swap(nodeCell);
+    g_.assign(cells_.size(), 0.f);
+    parent_.assign(cells_.size(), -1);
+    stamp_.assign(cells_.size(), 0);
+    closed_.assign(cells_.size(), 0);
+    generation_ = 0;
+    return true;
+}
+
+// costs are in lattice steps; every step has the same length
+float JumpPointSearch::heuristic(int cell) const {
+    return (float)(std::abs(cell % cols_ - goalCell_ % cols_) +
+                   std::abs(cell / cols_ - goalCell_ / cols_));
+}
+
+int JumpPointSearch::jumpVertical(int x, int y, int dy) const {
+    for (;;) {
+        int py = y;
+        y += dy;
+        if (!free(x, y))
+            return -1;
+        int cell = y * cols_ + x;
+        if (cell == goalCell_)
+            return cell;
+        // side opens up right after a wall: turning there is forced
+        if ((free(x - 1, y) && !free(x - 1, py)) ||
+            (free(x + 1, y) && !free(x + 1, py)))
+            return cell;
+    }
+}
+
+int JumpPointSearch::jumpHorizontal(int x, int y, int dx) const {
+    for (;;) {
+        x += dx;
+        if (!free(x, y))
+            return -1;
+        int cell = y * cols_ + x;
+        if (cell == goalCell_)
+            return cell;
+        if (jumpVertical(x, y, -1) >= 0 || jumpVertical(x, y, 1) >= 0)
+            return cell;
+    }
+}
+
+void JumpPointSearch::push(int cell, int parentCell, float g) {
+    if (closed_[cell] == generation_)
+        return;
+    if (stamp_[cell] == generation_ && g_[cell] <= g)
+        return;
+    g_[cell]      = g;
+    parent_[cell] = parentCell;
+    stamp_[cell]  = generation_;
+    open_.push_back({ g + heuristic(cell), cell });
+    std::push_heap(open_.begin(), open_.end(), std::greater<std::pair<float,int>>());
+}
+
+bool JumpPointSearch::search(int startIdx, int goalIdx, std::vector<int>& path) {
+    path.clear();
+    expanded_ = 0;
+    if (cells_.empty())
+        return false;
+
+    if (++generation_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        std::fill(closed_.begin(), closed_.end(), 0);
+        generation_ = 1;
+    }
+    open_.clear();
+    auto heapCmp = std::greater<std::pair<float,int>>();
+
+    int startCell = nodeCell_[startIdx];
+    goalCell_     = nodeCell_[goalIdx];
+    push(startCell, -1, 0.f);
+
+    while (!open_.empty()) {
+        std::pop_heap(open_.begin(), open_.end(), heapCmp);
+        int cell = open_.back().second;
+        open_.pop_back();
+        if (closed_[cell] == generation_)
+            continue;
+        closed_[cell] = generation_;
+        ++expanded_;
+
+        if (cell == goalCell_) {
+            // fill in the lattice steps between consecutive jump points
+            for (int at = cell; parent_[at] != -1; at = parent_[at]) {
+                int from = parent_[at];
+                int step = (at / cols_ == from / cols_) ? (at > from ? 1 : -1)
+                                                        : (at > from ? cols_ : -cols_);
+                for (int c = at; c != from; c -= step)
+                    path.push_back(cells_[c]);
+            }
+            path.push_back(startIdx);
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        int x = cell % cols_, y = cell / cols_;
+        float g = g_[cell];
+        auto jumpTo = [&](int jp) {
+            if (jp >= 0)
+                push(jp, cell, g + (float)(std::abs(jp % cols_ - x) + std::abs(jp / cols_ - y)));
+        };
+
+        int from = parent_[cell];
+        if (from < 0) {
+            jumpTo(jumpHorizontal(x, y, -1));
+            jumpTo(jumpHorizontal(x, y,  1));
+            jumpTo(jumpVertical(x, y, -1));
+            jumpTo(jumpVertical(x, y,  1));
+        } else if (from / cols_ == y) {
+            // arrived horizontally: keep going, and turn either way
+            jumpTo(jumpHorizontal(x, y, x > from % cols_ ? 1 : -1));
+            jumpTo(jumpVertical(x, y, -1));
+            jumpTo(jumpVertical(x, y,  1));
+        } else {
+            // arrived vertically: keep going, turn only where forced
+            int dy = y > from / cols_ ? 1 : -1;
+            jumpTo(jumpVertical(x, y, dy));
+            int py = y - dy;
+            if (free(x - 1, y) && !free(x - 1, py)) jumpTo(jumpHorizontal(x, y, -1));
+            if (free(x + 1, y) && !free(x + 1, py)) jumpTo(jumpHorizontal(x, y,  1));
+        }
+    }
+    return false;
+}
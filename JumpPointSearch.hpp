@@ -0,0 +1,70 @@
+// JumpPointSearch.hpp
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "Node.hpp"
+
+/// Jump Point Search for the 4‐connected lattice graphs createGraphGrid
+/// builds. The node set is turned into an occupancy grid (a node is a free
+/// cell; walls and removed points are simply missing nodes), and the search
+/// jumps along rows and columns instead of pushing every cell.
+///
+/// Canonical paths turn from horizontal to vertical anywhere, but from
+/// vertical to horizontal only where a wall forces it, so:
+///  - a horizontal jump stops where a vertical jump from it finds something;
+///  - a vertical jump stops at the goal or at a forced side neighbor (side
+///    cell free, the cell behind it blocked).
+///
+/// search() returns the full node path (every lattice step), with the same
+/// cost as AStar(). One instance per agent or per thread, like
+/// PathSearchContext.
+class JumpPointSearch {
+public:
+    /// Builds the occupancy grid. Returns false (and covers() stays false)
+    /// unless nodes sit on one `spacing` lattice linked exactly to their
+    /// 4 lattice neighbors.
+    bool build(const std::vector<Node>& nodes, float spacing);
+
+    /// True if built for exactly this node vector.
+    bool covers(const std::vector<Node>& nodes) const {
+        return nodes_ == &nodes && count_ == nodes.size() && !cells_.empty();
+    }
+
+    /// Writes start..goal (both included) into path; false (path empty) if
+    /// the goal is unreachable.
+    bool search(int startIdx, int goalIdx, std::vector<int>& path);
+
+    /// Jump points expanded by the last search (compare PathSearchContext).
+    int expanded() const { return expanded_; }
+
+    int cols() const { return cols_; }
+    int rows() const { return rows_; }
+
+private:
+    const std::vector<Node>* nodes_ = nullptr;
+    std::size_t              count_ = 0;
+    int                      cols_  = 0, rows_ = 0;
+    std::vector<int>         cells_;      // cell → node index, -1 if blocked
+    std::vector<int>         nodeCell_;   // node index → cell
+
+    // search state per cell, valid iff stamp_ == generation_
+    std::vector<float>    g_;
+    std::vector<int>      parent_;
+    std::vector<uint32_t> stamp_;
+    std::vector<uint32_t> closed_;
+    std::vector<std::pair<float,int>> open_;
+    uint32_t generation_ = 0;
+    int      expanded_   = 0;
+    int      goalCell_   = -1;
+
+    bool free(int x, int y) const {
+        return x >= 0 && y >= 0 && x < cols_ && y < rows_ &&
+               cells_[(std::size_t)y * cols_ + x] >= 0;
+    }
+    int  jumpHorizontal(int x, int y, int dx) const;
+    int  jumpVertical(int x, int y, int dy) const;
+    void push(int cell, int parentCell, float g);
+    float heuristic(int cell) const;
+};
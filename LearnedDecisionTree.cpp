@@ -0,0 +1,127 @@
+// LearnedDecisionTree.cpp
+#include "LearnedDecisionTree.hpp"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>
+
+const char* LearnedDecisionTree::featureName(Feature f) {
+    switch (f) {
+        case Feature::Room:  return "room";
+        case Feature::Aggro: return "aggro";
+        case Feature::Wall:  return "wall";
+        case Feature::Dist:  return "dist";
+    }
+    return "?";
+}
+
+bool LearnedDecisionTree::compile(const nlohmann::json& tree, std::string* error) {
+    nodes_.clear();
+    children_.clear();
+    std::string err;
+    if (lower(tree, err) < 0) {
+        nodes_.clear();
+        children_.clear();
+        if (error) *error = err;
+        return false;
+    }
+    return true;
+}
+
+bool LearnedDecisionTree::load(const std::string& path, std::string* error) {
+    std::ifstream in(path);
+    if (!in) {
+        if (error) *error = "can't open " + path;
+        return false;
+    }
+    nlohmann::json tree = nlohmann::json::parse(in, nullptr, /*allow_exceptions=*/false);
+    if (tree.is_discarded()) {
+        if (error) *error = path + " is not valid JSON";
+        return false;
+    }
+    return compile(tree, error);
+}
+
+// appends the node (children before grandchildren, so each node's child
+// table is contiguous) and returns its index, or -1 with `error` set
+int32_t LearnedDecisionTree::lower(const nlohmann::json& node, std::string& error) {
+    if (!node.is_object()) {
+        error = "tree node is not an object";
+        return -1;
+    }
+    int32_t self = (int32_t)nodes_.size();
+    Node n{};
+    nodes_.push_back(n);
+
+    auto label = node.find("label");
+    if (label != node.end()) {
+        if (!label->is_string() ||
+            !parseAction(label->get_ref<const std::string&>().c_str(), nodes_[self].label)) {
+            error = "unknown label " + label->dump();
+            return -1;
+        }
+        return self;
+    }
+
+    auto attr = node.find("attr");
+    if (attr == node.end() || !attr->is_string()) {
+        error = "node has neither \"label\" nor \"attr\"";
+        return -1;
+    }
+    const std::string& a = attr->get_ref<const std::string&>();
+    Feature f;
+    if      (a == "room")  f = Feature::Room;
+    else if (a == "aggro") f = Feature::Aggro;
+    else if (a == "wall")  f = Feature::Wall;
+    else if (a == "dist")  f = Feature::Dist;
+    else {
+        error = "unknown attr \"" + a + "\"";
+        return -1;
+    }
+    nodes_[self].feature = f;
+    nodes_[self].first   = (uint32_t)children_.size();
+
+    if (f == Feature::Dist) {
+        auto thresh = node.find("thresh");
+        if (thresh == node.end() || !thresh->is_number() ||
+            !node.contains("le") || !node.contains("gt")) {
+            error = "dist node needs \"thresh\", \"le\" and \"gt\"";
+            return -1;
+        }
+        nodes_[self].thresh = thresh->get<float>();
+        nodes_[self].count  = 2;
+        children_.resize(children_.size() + 2, -1);
+        int32_t le = lower(node["le"], error);
+        if (le < 0) return -1;
+        int32_t gt = lower(node["gt"], error);
+        if (gt < 0) return -1;
+        children_[nodes_[self].first]     = le;
+        children_[nodes_[self].first + 1] = gt;
+        return self;
+    }
+
+    // nominal: {"branches": {"<value>": subtree, ...}}, values small ints
+    auto branches = node.find("branches");
+    if (branches == node.end() || !branches->is_object() || branches->empty()) {
+        error = "\"" + a + "\" node needs \"branches\"";
+        return -1;
+    }
+    int maxValue = -1;
+    for (auto it = branches->begin(); it != branches->end(); ++it) {
+        char* end = nullptr;
+        long v = std::strtol(it.key().c_str(), &end, 10);
+        if (it.key().empty() || *end || v < 0 || v > 255) {
+            error = "bad branch value \"" + it.key() + "\"";
+            return -1;
+        }
+        maxValue = std::max(maxValue, (int)v);
+    }
+    nodes_[self].count = (uint16_t)(maxValue + 1);
+    children_.resize(children_.size() + maxValue + 1, -1);
+    for (auto it = branches->begin(); it != branches->end(); ++it) {
+        int32_t c = lower(it.value(), error);
+        if (c < 0) return -1;
+        children_[nodes_[self].first + std::atoi(it.key().c_str())] = c;
+    }
+    return self;
+}
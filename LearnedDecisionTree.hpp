@@ -0,0 +1,71 @@
+// LearnedDecisionTree.hpp
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <nlohmann/json_fwd.hpp>
+#include "MonsterAction.hpp"
+
+/// A decision tree from learn_dt.py, compiled once at load into a node
+/// array: string attributes become feature IDs, labels become
+/// MonsterAction, and "branches" objects become dense child tables indexed
+/// by the feature value. evaluate() is a short loop with no allocation and
+/// no string work.
+///
+/// A feature value the learner never saw below a node (no branch for it)
+/// yields fallback(), Wander unless set otherwise.
+class LearnedDecisionTree {
+public:
+    enum class Feature : uint8_t { Room, Aggro, Wall, Dist };
+
+    struct Node {
+        Feature       feature;
+        MonsterAction label;     // leaves
+        uint16_t      count;     // children; 0 for a leaf, 2 for dist (le, gt)
+        uint32_t      first;     // into children()
+        float         thresh;    // dist: le if dist <= thresh
+    };
+
+    /// Compiles the JSON tree; on failure returns false, leaves the tree
+    /// empty and describes the problem in *error.
+    bool compile(const nlohmann::json& tree, std::string* error = nullptr);
+
+    /// Reads and compiles a JSON file (learn_dt.py's stdout).
+    bool load(const std::string& path, std::string* error = nullptr);
+
+    bool empty() const { return nodes_.empty(); }
+
+    MonsterAction evaluate(const MonsterFeatures& f) const {
+        const Node* n = nodes_.data();
+        while (n->count) {
+            int v;
+            switch (n->feature) {
+                case Feature::Room:  v = f.room;  break;
+                case Feature::Aggro: v = f.aggro; break;
+                case Feature::Wall:  v = f.wall;  break;
+                default:             v = !(f.dist <= n->thresh); break;
+            }
+            if ((unsigned)v >= n->count || children_[n->first + v] < 0)
+                return fallback_;
+            n = &nodes_[children_[n->first + v]];
+        }
+        return n->label;
+    }
+
+    MonsterAction fallback() const          { return fallback_; }
+    void          setFallback(MonsterAction a) { fallback_ = a; }
+
+    // the compiled form, for code generation; nodes()[0] is the root
+    const std::vector<Node>&    nodes()    const { return nodes_; }
+    const std::vector<int32_t>& children() const { return children_; }
+
+    static const char* featureName(Feature f);
+
+private:
+    std::vector<Node>    nodes_;
+    std::vector<int32_t> children_;   // node index, or -1 for no branch
+    MonsterAction        fallback_ = MonsterAction::Wander;
+
+    int32_t lower(const nlohmann::json& node, std::string& error);
+};
@@ -0,0 +1,44 @@
+// MonsterAction.hpp
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+/// What a monster is doing, as recorded in monster_data.csv ("wander",
+/// "chase", "reset") and predicted by learned decision trees.
+enum class MonsterAction : uint8_t {
+    Wander,
+    Chase,
+    Reset,
+};
+
+inline const char* actionName(MonsterAction a) {
+    switch (a) {
+        case MonsterAction::Wander: return "wander";
+        case MonsterAction::Chase:  return "chase";
+        case MonsterAction::Reset:  return "reset";
+    }
+    return "?";
+}
+
+/// False if name isn't one of the recorded labels.
+inline bool parseAction(const char* name, MonsterAction& out) {
+    for (MonsterAction a : { MonsterAction::Wander, MonsterAction::Chase, MonsterAction::Reset })
+        if (!std::strcmp(name, actionName(a))) {
+            out = a;
+            return true;
+        }
+    return false;
+}
+
+/// The inputs a learned tree decides from: one monster_data.csv row.
+struct MonsterFeatures {
+    int   room;     // getRoomId() of the monster
+    float dist;     // to the player
+    bool  aggro;    // dist < 400
+    bool  wall;     // probe 10px ahead is inside a wall
+};
+
+/// A learned tree compiled to C++ by dtgen.
+using LearnedTreeFn = MonsterAction (*)(const MonsterFeatures&);
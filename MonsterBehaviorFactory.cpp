@@ -20,3 +20,13 @@ BTNode* MonsterBehaviorFactory::buildTree(
     // top‐level selector: try catchSeq first, else wander
     return new SelectorNode({ catchSeq, wander });
 }
+
+FlatBehaviorTree MonsterBehaviorFactory::buildFlatTree() {
+    FlatBehaviorTree t;
+    int chase    = t.chase();
+    int reset    = t.reset();
+    int catchSeq = t.sequence({ chase, reset });
+    int wander   = t.wander();
+    t.selector({ catchSeq, wander });
+    return t;
+}
@@ -1,8 +1,14 @@
 #pragma once
 #include "BTNode.hpp"
+#include "FlatBehaviorTree.hpp"
 
 namespace MonsterBehaviorFactory {
     BTNode* buildTree(const sf::Vector2f& monStart,
                       const sf::Vector2f& plyStart,
                       float eatRadius);
+
+    /// The same chase‐then‐reset / wander tree as one flat node array,
+    /// built once and shared by every monster (the start positions move to
+    /// each monster's blackboard).
+    FlatBehaviorTree buildFlatTree();
 }
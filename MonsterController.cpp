@@ -10,19 +10,80 @@ MonsterController::MonsterController(
     const sf::Vector2f&                    monStart,
     const sf::Vector2f&                    plyStart,
     float                                  eatRadius)
+  : MonsterController(graph, walls, monStart, plyStart, eatRadius)
 {
-    world_.monster    = &monster;
-    world_.player     = &player;
-    world_.graphNodes = &graph;
-    world_.walls      = &walls;
-    world_.eatRadius  = eatRadius;
-    world_.lastAction = "";
+    world_.monster = &monster;
+    world_.player  = &player;
+}
 
+MonsterController::MonsterController(
+    const std::vector<Node>&               graph,
+    const std::vector<sf::RectangleShape>& walls,
+    const sf::Vector2f&                    monStart,
+    const sf::Vector2f&                    plyStart,
+    float                                  eatRadius)
+  : flat_(nullptr)
+{
+    initWorld(graph, walls, eatRadius);
     root_ = MonsterBehaviorFactory::buildTree(
         monStart, plyStart, eatRadius
     );
 }
 
+MonsterController::MonsterController(
+    const FlatBehaviorTree&                tree,
+    const std::vector<Node>&               graph,
+    const std::vector<sf::RectangleShape>& walls,
+    const sf::Vector2f&                    monStart,
+    const sf::Vector2f&                    plyStart,
+    float                                  eatRadius)
+  : root_(nullptr)
+  , flat_(&tree)
+{
+    initWorld(graph, walls, eatRadius);
+    blackboard_.reset.monStart = monStart;
+    blackboard_.reset.plyStart = plyStart;
+}
+
+void MonsterController::initWorld(
+    const std::vector<Node>&               graph,
+    const std::vector<sf::RectangleShape>& walls,
+    float                                  eatRadius)
+{
+    world_.monster    = nullptr;
+    world_.player     = nullptr;
+    world_.playerOut  = nullptr;
+    world_.wrotePlayer = false;
+    world_.graphNodes = &graph;
+    world_.walls      = &walls;
+    world_.eatRadius  = eatRadius;
+    world_.routes     = nullptr;
+    world_.flowFields = nullptr;
+    world_.hpa        = nullptr;
+    world_.scheduler  = nullptr;
+    world_.asyncPaths = nullptr;
+    world_.incrementalChase = false;
+    world_.rng.seed(Rng::agentSeed());
+    world_.justReset  = false;
+    world_.lastAction = MonsterAction::Wander;
+}
+
 void MonsterController::update(float dt) {
-    root_->tick(world_, dt);
+    if (flat_) flat_->tick(blackboard_, world_, dt);
+    else       root_->tick(world_, dt);
+}
+
+void MonsterController::update(Kinematic& monster, Kinematic& player, float dt) {
+    world_.monster = &monster;
+    world_.player  = &player;
+    update(dt);
+}
+
+bool MonsterController::update(Kinematic& monster, Kinematic& player,
+                               Kinematic& playerOut, float dt) {
+    world_.playerOut   = &playerOut;
+    world_.wrotePlayer = false;
+    update(monster, player, dt);
+    world_.playerOut   = nullptr;
+    return world_.wrotePlayer;
 }
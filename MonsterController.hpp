@@ -3,6 +3,7 @@
 
 #include "BTNode.hpp"
 #include "Node.hpp"
+#include "FlatBehaviorTree.hpp"
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <string>
@@ -18,13 +19,65 @@ public:
                       const sf::Vector2f&                    plyStart,
                       float                                   eatRadius);
 
+    /// Unbound controller: the kinematics are passed to every update()
+    /// (used when agents live in an AgentStore).
+    MonsterController(const std::vector<Node>&               graph,
+                      const std::vector<sf::RectangleShape>& walls,
+                      const sf::Vector2f&                    monStart,
+                      const sf::Vector2f&                    plyStart,
+                      float                                   eatRadius);
+
+    /// Unbound controller ticking a shared flat tree (see
+    /// MonsterBehaviorFactory::buildFlatTree); `tree` must outlive it.
+    /// Its per‐monster state is an inline blackboard, so it allocates no
+    /// tree nodes of its own.
+    MonsterController(const FlatBehaviorTree&                tree,
+                      const std::vector<Node>&               graph,
+                      const std::vector<sf::RectangleShape>& walls,
+                      const sf::Vector2f&                    monStart,
+                      const sf::Vector2f&                    plyStart,
+                      float                                   eatRadius);
+
     void update(float dt);
+    void update(Kinematic& monster, Kinematic& player, float dt);
+
+    /// Same, but player is only read: a reset teleport goes to playerOut
+    /// instead. Returns true if it wrote playerOut.
+    bool update(Kinematic& monster, Kinematic& player, Kinematic& playerOut, float dt);
+
+    /// Chase by table lookup instead of A* (nullptr = A*). A table that
+    /// wasn't built for navGraph (empty, or another graph) is ignored.
+    void setRoutingTable(const RoutingTable* routes) { world_.routes = routes; }
+
+    /// Chase by reading a flow field shared with other monsters.
+    void setFlowFields(FlowFieldService* fields) { world_.flowFields = fields; }
+
+    /// Plan wander trips on the region graph, refining one leg at a time.
+    void setHierarchicalPlanner(HierarchicalPlanner* hpa) { world_.hpa = hpa; }
 
-    std::string getLastActionName() const {
+    /// Queue A* searches on a per‐frame budget; tasks wait (Running) for them.
+    void setPathScheduler(PathScheduler* scheduler) { world_.scheduler = scheduler; }
+
+    /// Run A* on worker threads; tasks pick results up on a later tick.
+    void setAsyncPaths(AsyncPathService* service) { world_.asyncPaths = service; }
+
+    /// Chase with a per‐monster incremental planner instead of A*.
+    void setIncrementalChase(bool on) { world_.incrementalChase = on; }
+
+    /// Fix this monster's random draws (wander goals, random selectors).
+    void seed(uint64_t s) { world_.rng.seed(s); }
+
+    MonsterAction getLastAction() const {
         return world_.lastAction;
     }
 
 private:
-    WorldState world_;
-    BTNode*    root_;
+    WorldState              world_;
+    BTNode*                 root_;        // pointer tree, or
+    const FlatBehaviorTree* flat_;        // shared flat tree + blackboard_
+    MonsterBlackboard       blackboard_;
+
+    void initWorld(const std::vector<Node>&               graph,
+                   const std::vector<sf::RectangleShape>& walls,
+                   float                                   eatRadius);
 };
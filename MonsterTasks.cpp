@@ -1,69 +1,58 @@
 #include "MonsterTasks.hpp"
-#include "Node.hpp"         // graphNodes, getClosestNode, AStar
+#include "Node.hpp"         // graphNodes, getClosestNode
+#include "PathSearchContext.hpp"
+#include "NavGraph.hpp"
+#include "RoutingTable.hpp"
+#include "FlowField.hpp"
+#include "PathScheduler.hpp"
+#include "AsyncPathService.hpp"
 #include "Steering.hpp"     // ArriveBehavior, AlignBehavior, vectorLength, mapToRange
-#include <cstdlib>
-#include <ctime>
 #include <cmath>
 
 // pull in the same nav‐mesh you filled in main()
 extern std::vector<Node> graphNodes;
 
-// seed rand()
-static bool _seeded = [](){
-    std::srand((unsigned)std::time(nullptr));
-    return true;
-}();
-
-// flag so we clear wander path after reset
-static bool gJustReset = false;
-
-// ——— ResetTask ——————————————————————————————————————————————
-ResetTask::ResetTask(const sf::Vector2f& monStart,
-                     const sf::Vector2f& plyStart)
-  : monStart_(monStart)
-  , plyStart_(plyStart)
-  , done_(false)
-{}
-
-Status ResetTask::tick(WorldState& w, float /*dt*/) {
-    w.lastAction = "reset";
-    if (!done_) {
+// ——— Reset ———————————————————————————————————————————————————
+Status tickReset(ResetState& s, WorldState& w) {
+    w.lastAction = MonsterAction::Reset;
+    if (!s.done) {
         // teleport both back
-        w.monster->position    = monStart_;
+        w.monster->position    = s.monStart;
         w.monster->velocity    = {0,0};
         w.monster->orientation = 0;
         w.monster->rotation    = 0;
-        w.player->position     = plyStart_;
-        w.player->velocity     = {0,0};
-        w.player->orientation  = 0;
-        w.player->rotation     = 0;
+        Kinematic& P = w.playerOut ? *w.playerOut : *w.player;
+        P.position             = s.plyStart;
+        P.velocity             = {0,0};
+        P.orientation          = 0;
+        P.rotation             = 0;
+        w.wrotePlayer          = true;
         // signal wander to clear paths
-        gJustReset = true;
-        done_      = true;
+        w.justReset = true;
+        s.done      = true;
         return Status::Running;
     }
-    done_ = false;
+    s.done = false;
     return Status::Success;
 }
 
-// ——— ChasePlayerTask —————————————————————————————————————
-ChasePlayerTask::ChasePlayerTask()
-  : aggroRange_(600.f)
-  , pathRange_(150.f)   // <<< chase when within 150px
-  , pathIdx_(0)
-{}
-
-// returns Running while path‑following, Success on “eat”, Failure if out of aggroRange_
-Status ChasePlayerTask::tick(WorldState& w, float dt) {
-    w.lastAction = "chase";
+// ——— Chase ———————————————————————————————————————————————————
+// returns Running while path‑following, Success on “eat”, Failure if out of aggroRange
+Status tickChase(ChaseState& c, WorldState& w, float dt,
+                 float aggroRange, float pathRange)
+{
+    w.lastAction = MonsterAction::Chase;
     Kinematic& M = *w.monster;
     Kinematic& P = *w.player;
     float      d = vectorLength(P.position - M.position);
 
     // if too far, give up → let tree fall through to Wander
-    if (d > aggroRange_) {
-        path_.clear();
-        pathIdx_ = 0;
+    if (d > aggroRange) {
+        c.path.clear();
+        c.pathIdx = 0;
+        if (w.scheduler) w.scheduler->cancel(c.ticket);
+        c.ticket  = PathTicket();
+        c.pending = {};
         return Status::Failure;
     }
     // if close enough to “eat”
@@ -71,24 +60,50 @@ Status ChasePlayerTask::tick(WorldState& w, float dt) {
         return Status::Success;
     }
     // if inside chase‑range, do A* then Arrive/Align at boosted speed
-    if (d < pathRange_) {
+    if (d < pathRange) {
         // clear old path once after reset
-        if (gJustReset) {
-            path_.clear();
-            pathIdx_ = 0;
-            gJustReset = false;
+        if (w.justReset) {
+            c.path.clear();
+            c.pathIdx = 0;
+            if (c.planner) c.planner->reset();
+            if (w.scheduler) w.scheduler->cancel(c.ticket);
+            c.ticket  = PathTicket();
+            c.pending = {};
+            w.justReset = false;
         }
 
-        // recompute full path to player every tick (you can optimize this if you like)
+        // recompute full path to player every tick (into c.path's buffer)
         int s = getClosestNode(M.position);
         int g = getClosestNode(P.position);
-        path_ = AStar(s, g);
+        if (w.routes && w.routes->nodeCount() == navGraph.size()) {
+            w.routes->route(s, g, c.path);
+        } else if (w.flowFields) {
+            // g is the field's own target; only the lookup is per monster
+            w.flowFields->towards(P).route(s, c.path);
+        } else if (w.incrementalChase) {
+            if (!c.planner) c.planner.reset(new IncrementalPlanner());
+            c.planner->plan(s, g, c.path);
+        } else if (w.scheduler) {
+            // keep following the previous path until the queued search lands
+            if (!c.ticket)
+                c.ticket = w.scheduler->request(s, g, PathPriority::Chase);
+            if (w.scheduler->poll(c.ticket, c.path) != PathStatus::Pending)
+                c.ticket = PathTicket();
+        } else if (w.asyncPaths) {
+            // same, with the search on a worker thread
+            if (!c.pending.valid())
+                c.pending = w.asyncPaths->request(s, g);
+            if (AsyncPathService::ready(c.pending))
+                c.path = c.pending.get();
+        } else {
+            threadPathContext().search(s, g, c.path);
+        }
 
-        if (!path_.empty()) {
+        if (!c.path.empty()) {
             // wrap or reset the index if it ran off
-            if (pathIdx_ >= (int)path_.size()) pathIdx_ = 0;
+            if (c.pathIdx >= (int)c.path.size()) c.pathIdx = 0;
             // target the next waypoint
-            sf::Vector2f goal = graphNodes[path_[pathIdx_]].position;
+            sf::Vector2f goal = navGraph.position(c.path[c.pathIdx]);
             sf::Vector2f diff = goal - M.position;
             Kinematic tgt{ goal, {0,0}, std::atan2(diff.y, diff.x), 0.f };
 
@@ -97,7 +112,7 @@ Status ChasePlayerTask::tick(WorldState& w, float dt) {
                 /*maxAccel=*/300.f,
                 /*maxSpeed=*/300.f,
                 /*targetRadius=*/5.f,
-                /*slowRadius=*/pathRange_,
+                /*slowRadius=*/pathRange,
                 /*timeToTarget=*/0.3f
             ).getSteering(M, tgt, dt);
 
@@ -117,7 +132,7 @@ Status ChasePlayerTask::tick(WorldState& w, float dt) {
             M.orientation  = mapToRange(M.orientation);
 
             // advance if we’ve reached this waypoint
-            if (vectorLength(diff) < 5.f) pathIdx_++;
+            if (vectorLength(diff) < 5.f) c.pathIdx++;
         }
         return Status::Running;
     }
@@ -126,34 +141,66 @@ Status ChasePlayerTask::tick(WorldState& w, float dt) {
     return Status::Failure;
 }
 
-// ——— GraphWanderTask —————————————————————————————————————————
-GraphWanderTask::GraphWanderTask()
-  : pathIdx_(0)
-{}
-
-Status GraphWanderTask::tick(WorldState& w, float dt) {
-    w.lastAction = "wander";
+// ——— Graph wander ————————————————————————————————————————————
+Status tickWander(WanderState& st, WorldState& w, float dt) {
+    w.lastAction = MonsterAction::Wander;
     Kinematic& m = *w.monster;
 
     // if just reset, clear out old wander path
-    if (gJustReset) {
-        path_.clear();
-        pathIdx_ = 0;
-        gJustReset = false;
+    if (w.justReset) {
+        st.path.clear();
+        st.pathIdx = 0;
+        st.route.clear();
+        if (w.scheduler) w.scheduler->cancel(st.ticket);
+        st.ticket  = PathTicket();
+        st.pending = {};
+        w.justReset = false;
     }
 
-    // if we’ve exhausted our wander path, pick a new random goal
-    if (pathIdx_ >= (int)path_.size()) {
-        int s = getClosestNode(m.position);
-        sf::Vector2f r{ float(std::rand()%640), float(std::rand()%480) };
-        int g = getClosestNode(r);
-        path_    = AStar(s, g);
-        pathIdx_ = 0;
+    // if we’ve exhausted our wander path, refine the next leg of the
+    // hierarchical route, or pick a new random goal
+    if (st.pathIdx >= (int)st.path.size()) {
+        if (w.hpa && w.hpa->refineNext(st.route, st.path)) {
+            st.pathIdx = 0;
+        } else if (st.ticket) {
+            // waiting on a queued search
+            if (w.scheduler->poll(st.ticket, st.path) == PathStatus::Pending)
+                return Status::Running;
+            st.ticket  = PathTicket();
+            st.pathIdx = 0;
+        } else if (st.pending.valid()) {
+            // waiting on a worker thread
+            if (!AsyncPathService::ready(st.pending))
+                return Status::Running;
+            st.path    = st.pending.get();
+            st.pathIdx = 0;
+        } else {
+            int s = getClosestNode(m.position);
+            sf::Vector2f r{ float(w.rng.below(640)), float(w.rng.below(480)) };
+            int g = getClosestNode(r);
+            if (w.hpa) {
+                w.hpa->plan(s, g, st.route);
+                w.hpa->refineNext(st.route, st.path);
+            } else if (w.scheduler) {
+                st.ticket = w.scheduler->request(s, g, PathPriority::Wander);
+                st.path.clear();
+                st.pathIdx = 0;
+                return Status::Running;
+            } else if (w.asyncPaths) {
+                st.pending = w.asyncPaths->request(s, g);
+                st.path.clear();
+                st.pathIdx = 0;
+                return Status::Running;
+            } else {
+                threadPathContext().search(s, g, st.path);
+            }
+            st.pathIdx = 0;
+        }
     }
 
     // follow it just like above (but with lower speed)
-    if (!path_.empty() && pathIdx_ < (int)path_.size()) {
-        sf::Vector2f goal = graphNodes[path_[pathIdx_]].position;
+    if (!st.path.empty() && st.pathIdx < (int)st.path.size()) {
+        sf::Vector2f goal = navGraph.position(st.path[st.pathIdx]);
         sf::Vector2f diff = goal - m.position;
         Kinematic tgt{ goal, {0,0}, std::atan2(diff.y, diff.x), 0.f };
 
@@ -179,8 +226,33 @@ Status GraphWanderTask::tick(WorldState& w, float dt) {
         m.orientation += m.rotation  * dt;
         m.orientation  = mapToRange(m.orientation);
 
-        if (vectorLength(diff) < 5.f) pathIdx_++;
+        if (vectorLength(diff) < 5.f) st.pathIdx++;
     }
 
     return Status::Running;
 }
+
+// ——— BTNode wrappers —————————————————————————————————————————————
+ResetTask::ResetTask(const sf::Vector2f& monStart,
+                     const sf::Vector2f& plyStart)
+{
+    state_.monStart = monStart;
+    state_.plyStart = plyStart;
+}
+
+Status ResetTask::tick(WorldState& w, float /*dt*/) {
+    return tickReset(state_, w);
+}
+
+ChasePlayerTask::ChasePlayerTask()
+  : aggroRange_(600.f)
+  , pathRange_(150.f)   // <<< chase when within 150px
+{}
+
+Status ChasePlayerTask::tick(WorldState& w, float dt) {
+    return tickChase(state_, w, dt, aggroRange_, pathRange_);
+}
+
+Status GraphWanderTask::tick(WorldState& w, float dt) {
+    return tickWander(state_, w, dt);
+}
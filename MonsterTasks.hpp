@@ -4,18 +4,60 @@
 #include "Node.hpp"
 #include "Steering.hpp"
 #include <vector>
+#include <memory>
+#include <future>
+#include "IncrementalPlanner.hpp"
+#include "HierarchicalPlanner.hpp"
+#include "PathScheduler.hpp"
+
+// Each task's per‐agent state is a plain struct, ticked by a free function.
+// The BTNode classes below wrap one of each for the pointer tree; the flat
+// tree (FlatBehaviorTree) keeps them in a per‐agent MonsterBlackboard.
 
 // ——— Reset —————————————————————————————————————————
+struct ResetState {
+    sf::Vector2f monStart, plyStart;
+    bool         done = false;
+};
+
+/// Teleports monster and player back to their starts (Running), then Success.
+Status tickReset(ResetState& s, WorldState& w);
+
+// ——— Chase (with path‐follow) ——————————————————————————————————
+struct ChaseState {
+    std::vector<int>   path;
+    int                pathIdx = 0;
+    std::unique_ptr<IncrementalPlanner> planner;   // only with incrementalChase
+    PathTicket         ticket;       // queued search (only with w.scheduler)
+    std::future<std::vector<int>> pending;   // only with w.asyncPaths
+};
+
+/// Running while chasing, Success on “eat”, Failure beyond aggroRange or
+/// outside pathRange.
+Status tickChase(ChaseState& s, WorldState& w, float dt,
+                 float aggroRange, float pathRange);
+
+// ——— Graph Wander —————————————————————————————————————
+struct WanderState {
+    std::vector<int> path;
+    int              pathIdx = 0;
+    HpaRoute         route;      // legs still to refine (only with w.hpa)
+    PathTicket       ticket;     // queued search (only with w.scheduler)
+    std::future<std::vector<int>> pending;   // only with w.asyncPaths
+};
+
+/// Follows random trips across the graph; always Running.
+Status tickWander(WanderState& s, WorldState& w, float dt);
+
+// ——— BTNode wrappers —————————————————————————————————————
 struct ResetTask : public BTNode {
     ResetTask(const sf::Vector2f& monStart,
               const sf::Vector2f& plyStart);
     virtual Status tick(WorldState& w, float dt) override;
 private:
-    sf::Vector2f monStart_, plyStart_;
-    bool         done_;
+    ResetState state_;
 };
 
-// ——— Chase (with path‐follow) ——————————————————————————————————
 struct ChasePlayerTask : public BTNode {
     ChasePlayerTask();
 
@@ -23,17 +65,13 @@ struct ChasePlayerTask : public BTNode {
     virtual Status tick(WorldState& w, float dt) override;
 
 private:
-    float              aggroRange_;  // beyond this → Failure → wander
-    float              pathRange_;   // within this → switch into path‑follow
-    std::vector<int>   path_;
-    int                pathIdx_;
+    float      aggroRange_;  // beyond this → Failure → wander
+    float      pathRange_;   // within this → switch into path‑follow
+    ChaseState state_;
 };
 
-// ——— Graph Wander —————————————————————————————————————
 struct GraphWanderTask : public BTNode {
-    GraphWanderTask();
     virtual Status tick(WorldState& w, float dt) override;
 private:
-    std::vector<int> path_;
-    int              pathIdx_;
+    WanderState state_;
 };
@@ -0,0 +1,48 @@
+// NavGraph.cpp
+#include "NavGraph.hpp"
+#include <cmath>
+
+NavGraph navGraph;
+
+void NavGraph::build(const std::vector<Node>& nodes) {
+    std::size_t edges = 0;
+    for (auto& n : nodes)
+        edges += n.neighbors.size();
+
+    // fresh buffers, so a smaller graph does not keep the old capacity
+    std::vector<sf::Vector2f>().swap(positions_);
+    std::vector<int>().swap(offsets_);
+    std::vector<int>().swap(targets_);
+    std::vector<float>().swap(costs_);
+    positions_.reserve(nodes.size());
+    offsets_.reserve(nodes.size() + 1);
+    targets_.reserve(edges);
+    costs_.reserve(edges);
+
+    offsets_.push_back(0);
+    for (auto& n : nodes) {
+        positions_.push_back(n.position);
+        for (int v : n.neighbors) {
+            float dx = n.position.x - nodes[v].position.x;
+            float dy = n.position.y - nodes[v].position.y;
+            targets_.push_back(v);
+            costs_.push_back(std::sqrt(dx*dx + dy*dy));
+        }
+        offsets_.push_back((int)targets_.size());
+    }
+}
+
+std::size_t NavGraph::bytes() const {
+    return sizeof(*this)
+         + positions_.capacity() * sizeof(sf::Vector2f)
+         + offsets_.capacity()   * sizeof(int)
+         + targets_.capacity()   * sizeof(int)
+         + costs_.capacity()     * sizeof(float);
+}
+
+std::size_t NavGraph::nodeVectorBytes(const std::vector<Node>& nodes) {
+    std::size_t b = sizeof(nodes) + nodes.capacity() * sizeof(Node);
+    for (auto& n : nodes)
+        b += n.neighbors.capacity() * sizeof(int);
+    return b;
+}
@@ -0,0 +1,40 @@
+// NavGraph.hpp
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include "Node.hpp"
+
+/// Compressed‐sparse‐row copy of a Node graph: node positions, per‐node
+/// edge offsets, edge targets and edge lengths in four flat arrays, so an
+/// expansion scans contiguous memory and never calls sqrt. The edges of
+/// node u are [edgeBegin(u), edgeEnd(u)), in the order of u's neighbors.
+class NavGraph {
+public:
+    void build(const std::vector<Node>& nodes);
+
+    int size()      const { return (int)positions_.size(); }
+    int edgeCount() const { return (int)targets_.size(); }
+
+    const sf::Vector2f& position(int i) const { return positions_[i]; }
+
+    int   edgeBegin(int u)  const { return offsets_[u]; }
+    int   edgeEnd(int u)    const { return offsets_[u + 1]; }
+    int   edgeTarget(int e) const { return targets_[e]; }
+    float edgeCost(int e)   const { return costs_[e]; }
+
+    /// Heap + inline bytes of this graph, and of the Node vector it came
+    /// from (for comparing the two layouts).
+    std::size_t bytes() const;
+    static std::size_t nodeVectorBytes(const std::vector<Node>& nodes);
+
+private:
+    std::vector<sf::Vector2f> positions_;
+    std::vector<int>          offsets_;   // size()+1 entries
+    std::vector<int>          targets_;
+    std::vector<float>        costs_;
+};
+
+// CSR copy of the global graphNodes (filled by createGraphGrid)
+extern NavGraph navGraph;
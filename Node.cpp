@@ -1,8 +1,9 @@
 // Node.cpp
 #include "Node.hpp"
-#include <queue>
+#include "NodeGridIndex.hpp"
+#include "PathSearchContext.hpp"
+#include "NavGraph.hpp"
 #include <cmath>
-#include <algorithm>
 
 static float nodeDistance(const sf::Vector2f& a, const sf::Vector2f& b) {
     float dx = a.x - b.x;
@@ -11,10 +12,19 @@ static float nodeDistance(const sf::Vector2f& a, const sf::Vector2f& b) {
 }
 
 int getClosestNode(const sf::Vector2f& pos) {
+    if (graphIndex.covers(graphNodes))
+        return graphIndex.closest(pos);
+
+    // no lattice index: linear scan, over the contiguous CSR positions
+    // when they are current
+    bool flat = navGraph.size() == (int)graphNodes.size();
+    auto at = [&](int i) -> const sf::Vector2f& {
+        return flat ? navGraph.position(i) : graphNodes[i].position;
+    };
     int bestIdx = 0;
-    float bestD = nodeDistance(pos, graphNodes[0].position);
+    float bestD = nodeDistance(pos, at(0));
     for (int i = 1; i < (int)graphNodes.size(); ++i) {
-        float d = nodeDistance(pos, graphNodes[i].position);
+        float d = nodeDistance(pos, at(i));
         if (d < bestD) {
             bestD = d;
             bestIdx = i;
@@ -23,40 +33,17 @@ int getClosestNode(const sf::Vector2f& pos) {
     return bestIdx;
 }
 
-std::vector<int> AStar(int startIdx, int goalIdx) {
-    int N = graphNodes.size();
-    std::vector<float> g(N, INFINITY), f(N, INFINITY);
-    std::vector<int> cameFrom(N, -1);
-    auto cmp = [&](int a,int b){ return f[a] > f[b]; };
-    std::priority_queue<int, std::vector<int>, decltype(cmp)> openSet(cmp);
-
-    g[startIdx] = 0;
-    f[startIdx] = nodeDistance(graphNodes[startIdx].position,
-                                graphNodes[goalIdx].position);
-    openSet.push(startIdx);
-
-    while (!openSet.empty()) {
-        int current = openSet.top(); openSet.pop();
-        if (current == goalIdx) {
-            std::vector<int> path;
-            for (int at = current; at != -1; at = cameFrom[at])
-                path.push_back(at);
-            std::reverse(path.begin(), path.end());
-            return path;
-        }
-        for (int nb : graphNodes[current].neighbors) {
-            float tentative = g[current] +
-                nodeDistance(graphNodes[current].position,
-                             graphNodes[nb].position);
-            if (tentative < g[nb]) {
-                cameFrom[nb] = current;
-                g[nb] = tentative;
-                f[nb] = tentative +
-                    nodeDistance(graphNodes[nb].position,
-                                 graphNodes[goalIdx].position);
-                openSet.push(nb);
-            }
-        }
+void getClosestNodes(const sf::Vector2f* pos, int* out, std::size_t n) {
+    if (graphIndex.covers(graphNodes)) {
+        graphIndex.closest(pos, out, n);
+        return;
     }
-    return {};
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = getClosestNode(pos[i]);
+}
+
+std::vector<int> AStar(int startIdx, int goalIdx) {
+    std::vector<int> path;
+    threadPathContext().search(startIdx, goalIdx, path);
+    return path;
 }
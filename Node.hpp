@@ -3,6 +3,7 @@
 
 #include <SFML/Graphics.hpp>
 #include <vector>
+#include <cstddef>
 
 struct Node {
     sf::Vector2f position;
@@ -14,4 +15,5 @@ extern std::vector<Node> graphNodes;
 
 // pathfinding helpers (defined in Node.cpp)
 int getClosestNode(const sf::Vector2f& pos);
-std::vector<int> AStar(int startIndx, int goalIndx);
+void getClosestNodes(const sf::Vector2f* pos, int* out, std::size_t n);  // batched
+std::vector<int> AStar(int startIndx, int goalIndx);  // allocates; see PathSearchContext
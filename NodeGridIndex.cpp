@@ -0,0 +1,95 @@
+// NodeGridIndex.cpp
+#include "NodeGridIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+NodeGridIndex graphIndex;
+
+void NodeGridIndex::build(const std::vector<Node>& nodes, float spacing) {
+    nodes_   = &nodes;
+    count_   = nodes.size();
+    spacing_ = spacing;
+    cells_.clear();
+    if (nodes.empty() || spacing <= 0.f)
+        return;
+
+    float minX = nodes[0].position.x, maxX = minX;
+    float minY = nodes[0].position.y, maxY = minY;
+    for (auto& n : nodes) {
+        minX = std::min(minX, n.position.x); maxX = std::max(maxX, n.position.x);
+        minY = std::min(minY, n.position.y); maxY = std::max(maxY, n.position.y);
+    }
+    originX_ = minX;
+    originY_ = minY;
+    cols_ = (int)std::lround((maxX - minX) / spacing) + 1;
+    rows_ = (int)std::lround((maxY - minY) / spacing) + 1;
+
+    std::vector<int> cells((std::size_t)cols_ * rows_, -1);
+    const float tolerance = 1e-3f * spacing;
+    for (int i = 0; i < (int)nodes.size(); ++i) {
+        float fx = (nodes[i].position.x - originX_) / spacing;
+        float fy = (nodes[i].position.y - originY_) / spacing;
+        int cx = (int)std::lround(fx);
+        int cy = (int)std::lround(fy);
+        int& cell = cells[(std::size_t)cy * cols_ + cx];
+        // off‐lattice or two nodes in one cell: not a lattice graph
+        if (std::abs(fx - cx) * spacing > tolerance ||
+            std::abs(fy - cy) * spacing > tolerance || cell != -1)
+            return;
+        cell = i;
+    }
+    cells_.swap(cells);
+}
+
+int NodeGridIndex::closest(const sf::Vector2f& pos) const {
+    const std::vector<Node>& nodes = *nodes_;
+    int cx = (int)std::lround((pos.x - originX_) / spacing_);
+    int cy = (int)std::lround((pos.y - originY_) / spacing_);
+    cx = std::max(0, std::min(cols_ - 1, cx));
+    cy = std::max(0, std::min(rows_ - 1, cy));
+
+    int   bestIdx = -1;
+    float bestD2  = std::numeric_limits<float>::infinity();
+    auto visit = [&](int x, int y) {
+        if (x < 0 || y < 0 || x >= cols_ || y >= rows_)
+            return;
+        int i = cells_[(std::size_t)y * cols_ + x];
+        if (i < 0)
+            return;
+        float dx = pos.x - nodes[i].position.x;
+        float dy = pos.y - nodes[i].position.y;
+        float d2 = dx*dx + dy*dy;
+        if (d2 < bestD2 || (d2 == bestD2 && i < bestIdx)) {
+            bestD2  = d2;
+            bestIdx = i;
+        }
+    };
+
+    // Every cell outside ring r is at least (r + 0.5) * spacing away from
+    // pos, so stop once the best hit is strictly closer than that.
+    int maxRing = std::max(cols_, rows_);
+    for (int r = 0; r <= maxRing; ++r) {
+        if (r == 0) {
+            visit(cx, cy);
+        } else {
+            for (int x = cx - r; x <= cx + r; ++x) {
+                visit(x, cy - r);
+                visit(x, cy + r);
+            }
+            for (int y = cy - r + 1; y <= cy + r - 1; ++y) {
+                visit(cx - r, y);
+                visit(cx + r, y);
+            }
+        }
+        float bound = (r + 0.5f) * spacing_;
+        if (bestIdx >= 0 && bestD2 < bound * bound)
+            break;
+    }
+    return bestIdx;
+}
+
+void NodeGridIndex::closest(const sf::Vector2f* pos, int* out, std::size_t n) const {
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = closest(pos[i]);
+}
@@ -0,0 +1,38 @@
+// NodeGridIndex.hpp
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include "Node.hpp"
+
+/// Cell → node table over a lattice graph (what createGraphGrid builds).
+/// A query rounds the position to its lattice cell and searches outward in
+/// square rings, so holes from walls or removed points cost a few extra
+/// cells instead of a scan over every node.
+class NodeGridIndex {
+public:
+    /// Indexes nodes laid out on a `spacing` lattice. If the nodes turn out
+    /// not to be on one lattice the index stays empty (covers() == false).
+    void build(const std::vector<Node>& nodes, float spacing);
+
+    /// True if this index was built for exactly this node vector.
+    bool covers(const std::vector<Node>& nodes) const {
+        return nodes_ == &nodes && count_ == nodes.size() && !cells_.empty();
+    }
+
+    /// Nearest node to pos (lowest index on ties, like the linear scan).
+    int  closest(const sf::Vector2f& pos) const;
+    void closest(const sf::Vector2f* pos, int* out, std::size_t n) const;
+
+private:
+    const std::vector<Node>* nodes_   = nullptr;
+    std::size_t              count_   = 0;
+    float                    spacing_ = 1.f;
+    float                    originX_ = 0.f, originY_ = 0.f;
+    int                      cols_    = 0,   rows_    = 0;
+    std::vector<int>         cells_;   // cols_*rows_, -1 where there is no node
+};
+
+// index over the global graphNodes (filled by createGraphGrid)
+extern NodeGridIndex graphIndex;
@@ -0,0 +1,86 @@
+// PathScheduler.cpp
+#include "PathScheduler.hpp"
+
+PathScheduler::PathScheduler(int expansionsPerFrame)
+  : budget_(expansionsPerFrame)
+{}
+
+PathTicket PathScheduler::request(int startIdx, int goalIdx, PathPriority priority) {
+    uint32_t id = nextId_++;
+    if (nextId_ == 0) nextId_ = 1;   // 0 stays "no ticket"
+    Request& r = requests_[id];
+    r.start    = startIdx;
+    r.goal     = goalIdx;
+    r.priority = priority;
+    queue_[(int)priority].push_back(id);
+    return { id };
+}
+
+PathStatus PathScheduler::poll(PathTicket ticket, std::vector<int>& path) {
+    auto it = requests_.find(ticket.id);
+    if (it == requests_.end())
+        return PathStatus::Failed;
+    PathStatus status = it->second.status;
+    if (status == PathStatus::Pending)
+        return status;
+    path.swap(it->second.path);
+    path.resize(status == PathStatus::Ready ? path.size() : 0);
+    requests_.erase(it);
+    return status;
+}
+
+void PathScheduler::cancel(PathTicket ticket) {
+    auto it = requests_.find(ticket.id);
+    if (it == requests_.end())
+        return;
+    release(it->second);
+    requests_.erase(it);   // its queue entry is skipped in update()
+}
+
+PathSearchContext* PathScheduler::acquire() {
+    if (freeContexts_.empty()) {
+        contexts_.emplace_back(new PathSearchContext());
+        return contexts_.back().get();
+    }
+    PathSearchContext* ctx = freeContexts_.back();
+    freeContexts_.pop_back();
+    return ctx;
+}
+
+void PathScheduler::release(Request& r) {
+    if (r.ctx) {
+        freeContexts_.push_back(r.ctx);
+        r.ctx = nullptr;
+    }
+}
+
+void PathScheduler::update() {
+    int left = budget_;
+    for (int c = 0; c < kClasses && left > 0; ++c) {
+        auto& queue = queue_[c];
+        while (!queue.empty() && left > 0) {
+            auto it = requests_.find(queue.front());
+            if (it == requests_.end()) {   // cancelled
+                queue.pop_front();
+                continue;
+            }
+            Request& r = it->second;
+            if (!r.ctx) {
+                r.ctx = acquire();
+                r.ctx->begin(r.start, r.goal);
+            }
+            int before = r.ctx->expanded();
+            PathSearchContext::State s = r.ctx->step(left);
+            left -= r.ctx->expanded() - before;
+            if (s == PathSearchContext::State::Running)
+                break;   // out of budget; resume next frame
+
+            r.ctx->extractPath(r.path);
+            r.status = (s == PathSearchContext::State::Found) ? PathStatus::Ready
+                                                              : PathStatus::Failed;
+            release(r);
+            queue.pop_front();
+        }
+    }
+    expandedLastFrame_ = budget_ - left;
+}
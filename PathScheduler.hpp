@@ -0,0 +1,73 @@
+// PathScheduler.hpp
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <cstdint>
+#include <unordered_map>
+#include "PathSearchContext.hpp"
+
+/// Lower value = served first.
+enum class PathPriority { Chase = 0, Wander = 1 };
+enum class PathStatus   { Pending, Ready, Failed };
+
+/// Handle for one queued request; id 0 means "no request".
+struct PathTicket {
+    uint32_t id = 0;
+    explicit operator bool() const { return id != 0; }
+};
+
+/// Path request queue with a fixed node‐expansion budget per frame. Agents
+/// request(), then poll() every tick until the path is ready; update(), once
+/// per frame, spends the budget on the queued searches, chase requests
+/// before wander ones and oldest first within a class. A search that runs
+/// out of budget resumes where it stopped next frame, so the AI's
+/// pathfinding time per frame is bounded no matter how many agents ask at
+/// once.
+///
+/// Only the search at the head of each class holds a PathSearchContext, so
+/// memory stays at a couple of contexts however long the queue gets.
+class PathScheduler {
+public:
+    explicit PathScheduler(int expansionsPerFrame = 2000);
+
+    PathTicket request(int startIdx, int goalIdx, PathPriority priority);
+
+    /// Pending, or Ready (path written, ticket released), or Failed (no
+    /// path or unknown ticket; ticket released).
+    PathStatus poll(PathTicket ticket, std::vector<int>& path);
+
+    /// Drops a request that is no longer wanted (no‐op for id 0).
+    void cancel(PathTicket ticket);
+
+    /// Spends this frame's budget. Call once per frame.
+    void update();
+
+    void setBudget(int expansionsPerFrame) { budget_ = expansionsPerFrame; }
+    int  budget()               const { return budget_; }
+    int  expandedLastFrame()    const { return expandedLastFrame_; }
+    std::size_t pending()       const { return requests_.size(); }
+
+private:
+    static constexpr int kClasses = 2;
+
+    struct Request {
+        int                start, goal;
+        PathPriority       priority;
+        PathStatus         status = PathStatus::Pending;
+        PathSearchContext* ctx    = nullptr;
+        std::vector<int>   path;
+    };
+
+    int      budget_;
+    int      expandedLastFrame_ = 0;
+    uint32_t nextId_ = 1;
+    std::unordered_map<uint32_t, Request> requests_;
+    std::deque<uint32_t>                  queue_[kClasses];   // pending ids, FIFO
+    std::vector<std::unique_ptr<PathSearchContext>> contexts_;
+    std::vector<PathSearchContext*>       freeContexts_;
+
+    PathSearchContext* acquire();
+    void               release(Request& r);
+};
@@ -0,0 +1,101 @@
+// PathSearchContext.cpp
+#include "PathSearchContext.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+static float nodeDistance(const sf::Vector2f& a, const sf::Vector2f& b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return std::sqrt(dx*dx + dy*dy);
+}
+
+void PathSearchContext::beginSearch() {
+    std::size_t n = (std::size_t)graph_->size();
+    if (stamp_.size() < n) {
+        g_.resize(n);
+        cameFrom_.resize(n);
+        stamp_.resize(n, 0);
+        closed_.resize(n, 0);
+    }
+    // stamps wrapped: old stamps could look current again, wipe them
+    if (++generation_ == 0) {
+        std::fill(stamp_.begin(), stamp_.end(), 0);
+        std::fill(closed_.begin(), closed_.end(), 0);
+        generation_ = 1;
+    }
+    open_.clear();
+    expanded_ = 0;
+}
+
+void PathSearchContext::begin(int startIdx, int goalIdx) {
+    beginSearch();
+    const NavGraph& graph = *graph_;
+    goal_  = goalIdx;
+    state_ = State::Running;
+
+    g_[startIdx]        = 0.f;
+    cameFrom_[startIdx] = -1;
+    stamp_[startIdx]    = generation_;
+    open_.push_back({ nodeDistance(graph.position(startIdx), graph.position(goalIdx)), startIdx });
+}
+
+PathSearchContext::State PathSearchContext::step(int maxExpansions) {
+    if (state_ != State::Running)
+        return state_;
+    const NavGraph& graph = *graph_;
+    const sf::Vector2f goalPos = graph.position(goal_);
+    auto heapCmp = std::greater<std::pair<float,int>>();
+
+    for (int budget = maxExpansions; budget > 0 && !open_.empty(); ) {
+        std::pop_heap(open_.begin(), open_.end(), heapCmp);
+        int current = open_.back().second;
+        open_.pop_back();
+        // stale duplicate: the heuristic is consistent, so the first pop
+        // of a node already had its best g
+        if (closed_[current] == generation_)
+            continue;
+        closed_[current] = generation_;
+        ++expanded_;
+        --budget;
+
+        if (current == goal_)
+            return state_ = State::Found;
+        for (int e = graph.edgeBegin(current), end = graph.edgeEnd(current); e < end; ++e) {
+            int   nb        = graph.edgeTarget(e);
+            float tentative = g_[current] + graph.edgeCost(e);
+            if (tentative < gScore(nb)) {
+                g_[nb]        = tentative;
+                cameFrom_[nb] = current;
+                stamp_[nb]    = generation_;
+                open_.push_back({ tentative + nodeDistance(graph.position(nb), goalPos), nb });
+                std::push_heap(open_.begin(), open_.end(), heapCmp);
+            }
+        }
+    }
+    if (open_.empty())
+        state_ = State::NoPath;
+    return state_;
+}
+
+void PathSearchContext::extractPath(std::vector<int>& path) const {
+    path.clear();
+    if (state_ != State::Found)
+        return;
+    for (int at = goal_; at != -1; at = cameFrom_[at])
+        path.push_back(at);
+    std::reverse(path.begin(), path.end());
+}
+
+bool PathSearchContext::search(int startIdx, int goalIdx, std::vector<int>& path) {
+    begin(startIdx, goalIdx);
+    step(std::numeric_limits<int>::max());
+    extractPath(path);
+    return state_ == State::Found;
+}
+
+PathSearchContext& threadPathContext() {
+    static thread_local PathSearchContext ctx;
+    return ctx;
+}
@@ -0,0 +1,58 @@
+// PathSearchContext.hpp
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include "NavGraph.hpp"
+
+/// Reusable A* over a NavGraph (navGraph, the CSR copy of graphNodes, by
+/// default). The per‐node buffers and the open list are kept between
+/// searches and invalidated with a generation stamp instead of being
+/// refilled, so a search allocates nothing once the buffers have grown to
+/// the graph size. Edge lengths come precomputed from the graph.
+///
+/// A search can also be run in slices (begin, then step() until it is no
+/// longer Running, then extractPath) to spread it over several frames.
+///
+/// One context per agent or per thread; a context is not thread‐safe.
+class PathSearchContext {
+public:
+    enum class State { Running, Found, NoPath };
+
+    explicit PathSearchContext(const NavGraph& graph = navGraph) : graph_(&graph) {}
+
+    /// Writes the path start..goal (both included) into `path`, reusing its
+    /// capacity. Returns false and leaves `path` empty if goal is unreachable.
+    bool search(int startIdx, int goalIdx, std::vector<int>& path);
+
+    /// Starts a search without expanding anything yet.
+    void  begin(int startIdx, int goalIdx);
+    /// Expands at most maxExpansions more nodes.
+    State step(int maxExpansions);
+    State state() const { return state_; }
+    /// start..goal into path once state() == Found (cleared otherwise).
+    void  extractPath(std::vector<int>& path) const;
+
+    /// Nodes expanded by the last (or current) search (for benchmarks).
+    int expanded() const { return expanded_; }
+
+private:
+    const NavGraph*       graph_;
+    std::vector<float>    g_;
+    std::vector<int>      cameFrom_;
+    std::vector<uint32_t> stamp_;      // g_/cameFrom_ valid iff stamp_ == generation_
+    std::vector<uint32_t> closed_;     // expanded iff closed_ == generation_
+    std::vector<std::pair<float,int>> open_;   // binary min‐heap on f
+    uint32_t              generation_ = 0;
+    int                   expanded_   = 0;
+    int                   goal_       = -1;
+    State                 state_      = State::NoPath;
+
+    void  beginSearch();
+    float gScore(int i) const { return stamp_[i] == generation_ ? g_[i] : INFINITY; }
+};
+
+/// Context owned by the calling thread; what AStar() and the BT tasks use.
+PathSearchContext& threadPathContext();
@@ -4,7 +4,7 @@ RandomSelectorNode::RandomSelectorNode(const std::vector<BTNode*>& c)
 
 Status RandomSelectorNode::tick(WorldState& w, float dt) {
     if (!chosen_) {
-        index_ = std::rand() % children_.size();
+        index_ = w.rng.below((int)children_.size());
         chosen_ = true;
     }
     Status s = children_[index_]->tick(w, dt);
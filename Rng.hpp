@@ -0,0 +1,47 @@
+// Rng.hpp
+#pragma once
+
+#include <cstdint>
+
+/// Small per‐agent PRNG (SplitMix64). Each agent owns one, so agents ticked
+/// on different threads never share generator state, and an agent's draws
+/// depend only on its seed, not on how many other agents drew before it.
+class Rng {
+public:
+    explicit Rng(uint64_t seed = 0) : state_(seed) {}
+
+    void     seed(uint64_t s) { state_ = s; }
+    uint64_t state() const    { return state_; }
+
+    uint32_t next() {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return uint32_t((z ^ (z >> 31)) >> 32);
+    }
+
+    /// Uniform integer in [0, n).
+    int below(int n) { return int(next() % uint32_t(n)); }
+
+    /// Uniform float in [0, 1).
+    float unit() { return float(next() >> 8) * (1.f / 16777216.f); }
+
+    /// Seed for a new agent: the next draw of a process‐wide seeder, so a
+    /// program that creates its agents in the same order gets the same
+    /// agents every run. Call on the thread that creates the agents.
+    static uint64_t agentSeed() {
+        uint64_t hi = seeder().next();
+        return (hi << 32) | seeder().next();
+    }
+
+    /// Restart the agent seeds from s (e.g. a run's recorded seed).
+    static void seedAgents(uint64_t s) { seeder().seed(s); }
+
+private:
+    uint64_t state_;
+
+    static Rng& seeder() {
+        static Rng r(0x243F6A8885A308D3ull);
+        return r;
+    }
+};
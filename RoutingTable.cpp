@@ -0,0 +1,111 @@
+// RoutingTable.cpp
+#include "RoutingTable.hpp"
+#include "PathSearchContext.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+static float nodeDistance(const sf::Vector2f& a, const sf::Vector2f& b) {
+    float dx = a.x - b.x;
+    float dy = a.y - b.y;
+    return std::sqrt(dx*dx + dy*dy);
+}
+
+bool RoutingTable::build(const std::vector<Node>& nodes) {
+    n_ = 0;
+    next_.clear();
+    if (nodes.empty() || nodes.size() >= kNone)
+        return false;
+
+    auto t0 = std::chrono::steady_clock::now();
+    int n = (int)nodes.size();
+    next_.assign((std::size_t)n * n, kNone);
+
+    std::vector<float> dist(n);
+    std::vector<std::pair<float,int>> heap;
+    auto heapCmp = std::greater<std::pair<float,int>>();
+
+    // Dijkstra outward from each destination; the node we relax v from is
+    // v's next hop toward that destination (edges are undirected)
+    for (int to = 0; to < n; ++to) {
+        uint16_t* row = &next_[(std::size_t)to * n];
+        std::fill(dist.begin(), dist.end(), std::numeric_limits<float>::infinity());
+        dist[to] = 0.f;
+        row[to]  = (uint16_t)to;
+        heap.clear();
+        heap.push_back({ 0.f, to });
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end(), heapCmp);
+            auto [d, u] = heap.back();
+            heap.pop_back();
+            if (d > dist[u])
+                continue;
+            for (int v : nodes[u].neighbors) {
+                float nd = d + nodeDistance(nodes[u].position, nodes[v].position);
+                if (nd < dist[v]) {
+                    dist[v] = nd;
+                    row[v]  = (uint16_t)u;
+                    heap.push_back({ nd, v });
+                    std::push_heap(heap.begin(), heap.end(), heapCmp);
+                }
+            }
+        }
+    }
+
+    n_ = n;
+    buildSeconds_ = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t0).count();
+    return true;
+}
+
+bool RoutingTable::route(int from, int to, std::vector<int>& path) const {
+    path.clear();
+    if (from < 0 || to < 0 || from >= n_ || to >= n_ || nextHop(from, to) < 0)
+        return false;
+    path.push_back(from);
+    for (int at = from; at != to; ) {
+        at = nextHop(at, to);
+        path.push_back(at);
+    }
+    return true;
+}
+
+void RoutingTable::report(std::ostream& out, int samples) const {
+    if (empty() || graphNodes.size() != (std::size_t)n_) {
+        out << "routing table: not built for graphNodes\n";
+        return;
+    }
+    std::vector<std::pair<int,int>> pairs(samples);
+    for (auto& p : pairs)
+        p = { std::rand() % n_, std::rand() % n_ };
+
+    std::vector<int> path;
+    path.reserve(n_);
+    using clock = std::chrono::steady_clock;
+
+    auto t0 = clock::now();
+    for (auto& p : pairs)
+        threadPathContext().search(p.first, p.second, path);
+    auto t1 = clock::now();
+    for (auto& p : pairs)
+        route(p.first, p.second, path);
+    auto t2 = clock::now();
+    volatile int sink = 0;
+    for (auto& p : pairs)
+        sink = sink + nextHop(p.first, p.second);
+    auto t3 = clock::now();
+
+    auto usPer = [&](clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count() / samples;
+    };
+    out << "routing table: " << n_ << " nodes, "
+        << bytes() / 1024.0 << " KiB, built in " << buildSeconds_ * 1000.0 << " ms\n"
+        << "  A* full path:     " << usPer(t1 - t0) << " us/query\n"
+        << "  table full path:  " << usPer(t2 - t1) << " us/query\n"
+        << "  table next hop:   " << usPer(t3 - t2) << " us/query\n";
+}
@@ -0,0 +1,46 @@
+// RoutingTable.hpp
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include "Node.hpp"
+
+/// All‐pairs next‐hop table for a static nav graph: one Dijkstra per
+/// destination, stored as uint16_t node indices. A path step is then a
+/// single lookup instead of an A* search. Memory is 2·N² bytes, so this is
+/// for small/medium maps; report() prints the numbers to decide per map.
+class RoutingTable {
+public:
+    /// Builds the table; returns false (and stays empty) if the graph has
+    /// more nodes than fit in uint16_t.
+    bool build(const std::vector<Node>& nodes);
+
+    bool        empty()     const { return n_ == 0; }
+    int         nodeCount() const { return n_; }
+    std::size_t bytes()     const { return next_.size() * sizeof(uint16_t); }
+    double      buildSeconds() const { return buildSeconds_; }
+
+    /// Next node on a shortest path from → to (to itself if from == to),
+    /// or -1 if unreachable.
+    int nextHop(int from, int to) const {
+        uint16_t h = next_[(std::size_t)to * n_ + from];
+        return h == kNone ? -1 : h;
+    }
+
+    /// Writes from..to (both included) into path; false if unreachable or
+    /// either node isn't in the table (e.g. it was never built).
+    bool route(int from, int to, std::vector<int>& path) const;
+
+    /// Memory, build time and per‐query latency against on‐demand A*
+    /// (threadPathContext) over `samples` random pairs of graphNodes.
+    void report(std::ostream& out, int samples = 2000) const;
+
+private:
+    static constexpr uint16_t kNone = 0xFFFF;
+
+    int                   n_ = 0;
+    std::vector<uint16_t> next_;          // row per destination: next_[to*n_ + from]
+    double                buildSeconds_ = 0.0;
+};
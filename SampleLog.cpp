@@ -0,0 +1,62 @@
+// SampleLog.cpp
+#include "SampleLog.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static bool fail(std::string* error, const std::string& what) {
+    if (error)
+        *error = what;
+    return false;
+}
+
+bool SampleLog::open(const std::string& path, std::string* error) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return fail(error, path + ": " + std::strerror(errno));
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        std::string why = std::strerror(errno);
+        ::close(fd);
+        return fail(error, path + ": " + why);
+    }
+    std::size_t size = std::size_t(st.st_size);
+    if (size < sizeof(SampleFileHeader)) {
+        ::close(fd);
+        return fail(error, path + ": not a sample file (too short)");
+    }
+    void* map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // the mapping keeps the file
+    if (map == MAP_FAILED)
+        return fail(error, path + ": mmap: " + std::strerror(errno));
+
+    // the header is 16 bytes and the map page aligned, so records are too
+    const SampleFileHeader* header = static_cast<const SampleFileHeader*>(map);
+    if (!isSampleFileHeader(*header)) {
+        ::munmap(map, size);
+        return fail(error, path + ": not a sample file (bad header or version)");
+    }
+    map_     = map;
+    mapSize_ = size;
+    records_ = reinterpret_cast<const SampleRecord*>(header + 1);
+    n_       = (size - sizeof(SampleFileHeader)) / sizeof(SampleRecord);
+    return true;
+}
+
+void SampleLog::close() {
+    if (map_)
+        ::munmap(map_, mapSize_);
+    map_     = nullptr;
+    mapSize_ = 0;
+    records_ = nullptr;
+    n_       = 0;
+}
+
+void SampleLog::adviseSequential() const {
+    if (map_)
+        ::madvise(map_, mapSize_, MADV_SEQUENTIAL);
+}
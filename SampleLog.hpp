@@ -0,0 +1,115 @@
+// SampleLog.hpp
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <string>
+#include "DataRecorder.hpp"    // for SampleRecord, Sample, the file header
+
+/// One field of every record in a SampleLog, read in place: a view of the
+/// mapped records with a stride of sizeof(SampleRecord) and a getter that
+/// pulls the field out of each. Nothing is copied or decoded up front.
+template <class Get>
+class SampleColumn {
+public:
+    using value_type = decltype(Get()(std::declval<const SampleRecord&>()));
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = SampleColumn::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = value_type;
+
+        explicit iterator(const SampleRecord* r = nullptr) : r_(r) {}
+        value_type operator*() const                  { return Get()(*r_); }
+        value_type operator[](difference_type i) const { return Get()(r_[i]); }
+        iterator&  operator++()                       { ++r_; return *this; }
+        iterator   operator++(int)                    { return iterator(r_++); }
+        iterator&  operator--()                       { --r_; return *this; }
+        iterator   operator--(int)                    { return iterator(r_--); }
+        iterator&  operator+=(difference_type n)      { r_ += n; return *this; }
+        iterator&  operator-=(difference_type n)      { r_ -= n; return *this; }
+        iterator   operator+(difference_type n) const { return iterator(r_ + n); }
+        iterator   operator-(difference_type n) const { return iterator(r_ - n); }
+        friend iterator operator+(difference_type n, iterator it) { return it + n; }
+        difference_type operator-(iterator o) const   { return r_ - o.r_; }
+        bool operator==(iterator o) const { return r_ == o.r_; }
+        bool operator!=(iterator o) const { return r_ != o.r_; }
+        bool operator<(iterator o)  const { return r_ <  o.r_; }
+        bool operator>(iterator o)  const { return r_ >  o.r_; }
+        bool operator<=(iterator o) const { return r_ <= o.r_; }
+        bool operator>=(iterator o) const { return r_ >= o.r_; }
+    private:
+        const SampleRecord* r_;
+    };
+
+    SampleColumn(const SampleRecord* records, std::size_t n) : r_(records), n_(n) {}
+
+    std::size_t size()  const { return n_; }
+    bool        empty() const { return n_ == 0; }
+    value_type  operator[](std::size_t i) const { return Get()(r_[i]); }
+
+    iterator begin() const { return iterator(r_); }
+    iterator end()   const { return iterator(r_ + n_); }
+
+    /// The underlying records, for code that wants the stride itself.
+    const SampleRecord* data()   const { return r_; }
+    static constexpr std::size_t stride() { return sizeof(SampleRecord); }
+
+private:
+    const SampleRecord* r_;
+    std::size_t         n_;
+};
+
+struct SampleRoom   { int   operator()(const SampleRecord& r) const { return r.room; } };
+struct SampleDist   { float operator()(const SampleRecord& r) const { return r.dist; } };
+struct SampleAggro  { bool  operator()(const SampleRecord& r) const { return (r.flags & kSampleAggro) != 0; } };
+struct SampleWall   { bool  operator()(const SampleRecord& r) const { return (r.flags & kSampleWall) != 0; } };
+struct SampleAction { MonsterAction operator()(const SampleRecord& r) const { return MonsterAction(r.action); } };
+
+/// A DataRecorder file mapped read‐only into memory. Opening costs a
+/// header check and an mmap, whatever the file size; records are paged in
+/// as the column views touch them. A partial record at the end (a run that
+/// was killed mid‐write) is left out.
+///
+///     SampleLog log;
+///     if (!log.open("monster_data.bin", &err)) ...
+///     for (float d : log.distToPlayer()) ...
+class SampleLog {
+public:
+    SampleLog() = default;
+    ~SampleLog() { close(); }
+
+    SampleLog(const SampleLog&)            = delete;
+    SampleLog& operator=(const SampleLog&) = delete;
+
+    /// Maps path; on failure returns false, leaves the log empty and
+    /// describes the problem in *error.
+    bool open(const std::string& path, std::string* error = nullptr);
+    void close();
+
+    bool        isOpen() const { return map_ != nullptr; }
+    std::size_t size()   const { return n_; }
+
+    const SampleRecord* records() const { return records_; }
+    Sample operator[](std::size_t i) const { return unpackSample(records_[i]); }
+
+    SampleColumn<SampleRoom>   roomId()       const { return { records_, n_ }; }
+    SampleColumn<SampleDist>   distToPlayer() const { return { records_, n_ }; }
+    SampleColumn<SampleAggro>  inAggro()      const { return { records_, n_ }; }
+    SampleColumn<SampleWall>   hittingWall()  const { return { records_, n_ }; }
+    SampleColumn<SampleAction> action()       const { return { records_, n_ }; }
+
+    /// Tells the kernel the records will be read front to back (read‐ahead).
+    void adviseSequential() const;
+
+private:
+    void*               map_     = nullptr;
+    std::size_t         mapSize_ = 0;
+    const SampleRecord* records_ = nullptr;
+    std::size_t         n_       = 0;
+};
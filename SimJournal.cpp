@@ -0,0 +1,165 @@
+// SimJournal.cpp
+#include "SimJournal.hpp"
+#include <cstring>
+
+static const char     kMagic[4] = { 'S', 'J', 'N', 'L' };
+static const uint32_t kVersion  = 1;
+
+// fixed‐width fields are written in host order (little endian on every
+// target this builds for)
+template <class T>
+static void put(std::ofstream& out, T v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <class T>
+static bool get(std::ifstream& in, T& v) {
+    return bool(in.read(reinterpret_cast<char*>(&v), sizeof(T)));
+}
+
+static void putVarint(std::ofstream& out, uint64_t v) {
+    while (v >= 0x80) {
+        out.put(char(uint8_t(v) | 0x80));
+        v >>= 7;
+    }
+    out.put(char(v));
+}
+
+static bool getVarint(std::ifstream& in, uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = in.get();
+        if (c == EOF)
+            return false;
+        v |= uint64_t(c & 0x7F) << shift;
+        if (!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+
+bool SimJournal::record(const std::string& path, uint64_t seed,
+                        const std::string& config, uint32_t checksumEvery)
+{
+    close();
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_)
+        return false;
+    seed_   = seed;
+    config_ = config;
+    every_  = checksumEvery;
+    out_.write(kMagic, 4);
+    put(out_, kVersion);
+    put(out_, seed_);
+    put(out_, every_);
+    put(out_, uint32_t(config_.size()));
+    out_.write(config_.data(), config_.size());
+    recording_ = true;
+    frames_ = checks_ = 0;
+    runCount_ = 0;
+    return bool(out_);
+}
+
+bool SimJournal::replay(const std::string& path) {
+    close();
+    in_.open(path, std::ios::binary);
+    char     magic[4];
+    uint32_t version = 0, configLen = 0;
+    if (!in_ || !in_.read(magic, 4) || std::memcmp(magic, kMagic, 4) != 0 ||
+        !get(in_, version) || version != kVersion ||
+        !get(in_, seed_) || !get(in_, every_) || !get(in_, configLen)) {
+        in_.close();
+        return false;
+    }
+    config_.resize(configLen);
+    if (!in_.read(&config_[0], configLen)) {
+        in_.close();
+        return false;
+    }
+    replaying_ = true;
+    frames_ = checks_ = 0;
+    runCount_ = 0;
+    return true;
+}
+
+void SimJournal::close() {
+    if (recording_) {
+        flushRun();
+        out_.close();
+    }
+    if (replaying_)
+        in_.close();
+    recording_ = replaying_ = false;
+}
+
+void SimJournal::flushRun() {
+    if (runCount_ == 0)
+        return;
+    out_.put('D');
+    put(out_, runDt_);
+    putVarint(out_, runCount_);
+    runCount_ = 0;
+}
+
+bool SimJournal::frame(float& dt) {
+    if (recording_) {
+        // compare bits, not values: a replay has to hand back the same float
+        if (runCount_ > 0 && std::memcmp(&dt, &runDt_, sizeof(float)) == 0) {
+            ++runCount_;
+        } else {
+            flushRun();
+            runDt_    = dt;
+            runCount_ = 1;
+        }
+    } else if (replaying_) {
+        if (runCount_ == 0) {
+            if (in_.get() != 'D' || !get(in_, runDt_) ||
+                !getVarint(in_, runCount_) || runCount_ == 0)
+                return false;
+        }
+        dt = runDt_;
+        --runCount_;
+    }
+    ++frames_;
+    return true;
+}
+
+bool SimJournal::check(uint64_t worldSum) {
+    if (!active() || every_ == 0 || frames_ % every_ != 0)
+        return true;
+    if (recording_) {
+        flushRun();
+        out_.put('C');
+        putVarint(out_, uint64_t(frames_));
+        put(out_, worldSum);
+        ++checks_;
+        return true;
+    }
+    // runs are flushed before every checksum, so it is next in the file;
+    // a journal cut short just has no more checksums
+    uint64_t frame = 0, expected = 0;
+    if (in_.peek() != 'C')
+        return true;
+    in_.get();
+    if (!getVarint(in_, frame) || !get(in_, expected))
+        return true;
+    if (frame != uint64_t(frames_) || expected != worldSum)
+        return false;
+    ++checks_;
+    return true;
+}
+
+uint64_t SimJournal::hash(const void* data, std::size_t n, uint64_t h) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < n; ++i) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t SimJournal::hash(const Kinematic& k, uint64_t h) {
+    float f[6] = { k.position.x, k.position.y, k.velocity.x, k.velocity.y,
+                   k.orientation, k.rotation };
+    return hash(f, sizeof(f), h);
+}
@@ -0,0 +1,87 @@
+// SimJournal.hpp
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include "Steering.hpp"     // for Kinematic
+
+/// Record of one simulation run, compact enough to keep next to a bug
+/// report: the run's seed, the tool's own config string, every frame's dt
+/// and a checksum of the world every N frames. Replaying it feeds the same
+/// dts back in, so a run seeded the same way repeats bit for bit, and a
+/// checksum that no longer matches pins down the first interval where it
+/// diverged.
+///
+/// The same calls drive both modes; a frame loop looks like
+///
+///     if (!journal.frame(dt)) break;   // records dt, or replaces it
+///     ... update the world with dt ...
+///     if (!journal.check(worldSum)) { report journal.frames(); break; }
+///
+/// File layout (little endian): "SJNL", u32 version, u64 seed,
+/// u32 checksumEvery, u32 config length, config bytes, then records:
+/// 'D' f32 dt, varint count (run of equal dts) and 'C' varint frame,
+/// u64 checksum (after that many frames).
+class SimJournal {
+public:
+    SimJournal() = default;
+    ~SimJournal() { close(); }
+
+    SimJournal(const SimJournal&)            = delete;
+    SimJournal& operator=(const SimJournal&) = delete;
+
+    /// Start recording to path; false if it can't be created.
+    bool record(const std::string& path, uint64_t seed,
+                const std::string& config, uint32_t checksumEvery = 60);
+
+    /// Open path for replay; false if unreadable or not a journal.
+    bool replay(const std::string& path);
+
+    void close();
+
+    bool recording() const { return recording_; }
+    bool replaying() const { return replaying_; }
+    bool active()    const { return recording_ || replaying_; }
+
+    uint64_t           seed()          const { return seed_; }
+    const std::string& config()        const { return config_; }
+    uint32_t           checksumEvery() const { return every_; }
+
+    /// Start of a frame. Recording: stores dt. Replaying: overwrites dt with
+    /// the recorded one, or returns false when the run is over.
+    bool frame(float& dt);
+
+    /// End of a frame, with the world checksum. Recording: stores it every
+    /// N frames. Replaying: compares it on those frames; false on mismatch.
+    bool check(uint64_t worldSum);
+
+    /// Frames begun so far, and checksums stored or matched.
+    long frames() const { return frames_; }
+    long checks() const { return checks_; }
+
+    // FNV‐1a, for building world checksums
+    static uint64_t hash(const void* data, std::size_t n,
+                         uint64_t h = 14695981039346656037ull);
+    static uint64_t hash(const Kinematic& k, uint64_t h = 14695981039346656037ull);
+
+private:
+    std::ofstream out_;
+    std::ifstream in_;
+    bool          recording_ = false;
+    bool          replaying_ = false;
+
+    uint64_t      seed_  = 0;
+    std::string   config_;
+    uint32_t      every_ = 60;
+
+    long          frames_ = 0;
+    long          checks_ = 0;
+
+    // current run of equal dts (being written, or left to hand out)
+    float         runDt_    = 0.f;
+    uint64_t      runCount_ = 0;
+
+    void flushRun();
+};
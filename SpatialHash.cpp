@@ -0,0 +1,30 @@
+// SpatialHash.cpp
+#include "SpatialHash.hpp"
+
+void SpatialHash::rebuild(const sf::Vector2f* positions, std::size_t n) {
+    // ~2 buckets per point keeps collisions rare
+    uint32_t buckets = 16;
+    while (buckets < 2 * n)
+        buckets <<= 1;
+    mask_ = buckets - 1;
+
+    cellStart_.assign(buckets + 1, 0);
+    bucketOf_.resize(n);
+    entries_.resize(n);
+
+    // count
+    for (std::size_t i = 0; i < n; ++i) {
+        uint32_t b = bucket(cellCoord(positions[i].x), cellCoord(positions[i].y));
+        bucketOf_[i] = b;
+        ++cellStart_[b + 1];
+    }
+    // prefix sum → start offsets
+    for (uint32_t b = 0; b < buckets; ++b)
+        cellStart_[b + 1] += cellStart_[b];
+    // scatter (cellStart_[b] is used as a cursor, then restored)
+    for (std::size_t i = 0; i < n; ++i)
+        entries_[cellStart_[bucketOf_[i]]++] = (uint32_t)i;
+    for (uint32_t b = buckets; b > 0; --b)
+        cellStart_[b] = cellStart_[b - 1];
+    cellStart_[0] = 0;
+}
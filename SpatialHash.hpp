@@ -0,0 +1,73 @@
+// SpatialHash.hpp
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+
+/// Uniform‐grid spatial hash over a set of points, rebuilt each frame with a
+/// counting sort (two linear passes, no per‐cell allocations). Cells are
+/// hashed into a power‐of‐two bucket table, so the world needs no bounds.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 1.f) : cellSize_(cellSize) {}
+
+    void  setCellSize(float cellSize) { cellSize_ = cellSize; }
+    float cellSize() const            { return cellSize_; }
+    std::size_t size() const          { return bucketOf_.size(); }
+
+    /// Re‐bins all points; point i keeps index i in query callbacks.
+    void rebuild(const sf::Vector2f* positions, std::size_t n);
+
+    /// Calls f(index) for every point in a cell touched by the square of
+    /// half‐width `radius` around p. Callers still do the exact distance test.
+    template <class F>
+    void forEachNear(const sf::Vector2f& p, float radius, F&& f) const;
+
+private:
+    float                 cellSize_;
+    uint32_t              mask_ = 0;      // bucket count - 1
+    std::vector<uint32_t> cellStart_;     // bucket → first entry (size mask_+2)
+    std::vector<uint32_t> entries_;       // point indices sorted by bucket
+    std::vector<uint32_t> bucketOf_;      // point → bucket
+
+    int cellCoord(float v) const { return (int)std::floor(v / cellSize_); }
+    uint32_t bucket(int cx, int cy) const {
+        uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u;
+        return h & mask_;
+    }
+};
+
+template <class F>
+void SpatialHash::forEachNear(const sf::Vector2f& p, float radius, F&& f) const {
+    if (entries_.empty())
+        return;
+    int x0 = cellCoord(p.x - radius), x1 = cellCoord(p.x + radius);
+    int y0 = cellCoord(p.y - radius), y1 = cellCoord(p.y + radius);
+
+    // radius much bigger than a cell: cheaper to walk every bucket once
+    if ((long long)(x1 - x0 + 1) * (y1 - y0 + 1) > 16) {
+        for (uint32_t e : entries_)
+            f(e);
+        return;
+    }
+
+    // two cells can hash to the same bucket; visit each bucket once
+    uint32_t seen[16];
+    int      seenCount = 0;
+    for (int cx = x0; cx <= x1; ++cx) {
+        for (int cy = y0; cy <= y1; ++cy) {
+            uint32_t b = bucket(cx, cy);
+            bool dup = false;
+            for (int k = 0; k < seenCount; ++k)
+                if (seen[k] == b) { dup = true; break; }
+            if (dup)
+                continue;
+            seen[seenCount++] = b;
+            for (uint32_t e = cellStart_[b]; e < cellStart_[b + 1]; ++e)
+                f(entries_[e]);
+        }
+    }
+}
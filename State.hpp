@@ -1,6 +1,16 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <cstdint>
+
+/// The State inputs a decision can test by index (see ConditionNode's
+/// structured form and CompiledDecisionTree).
+enum class StateFeature : uint8_t {
+    DistanceToTarget,
+    TimeInBehavior,
+    MinWallDist,
+    Speed,
+};
 
 /// Holds the agent’s sensory inputs for decision‑making.
 struct State {
@@ -19,4 +29,14 @@ struct State {
     bool nearWall() const    { return minWallDist      <  wallThreshold; }
     bool timedOut() const    { return timeInBehavior  >  behaviorTimeout; }
     bool isTooFast()  const { return speed > maxSpeedThreshold; }
+
+    float feature(StateFeature f) const {
+        switch (f) {
+            case StateFeature::DistanceToTarget: return distanceToTarget;
+            case StateFeature::TimeInBehavior:   return timeInBehavior;
+            case StateFeature::MinWallDist:      return minWallDist;
+            case StateFeature::Speed:            return speed;
+        }
+        return 0.f;
+    }
 };
@@ -5,6 +5,10 @@
 #include <cmath>
 #include <cstdlib>
 #include <vector>
+#include <functional>
+#include "SpatialHash.hpp"
+#include "FlockKernel.hpp"
+#include "Rng.hpp"
 
 
 const float PI = 3.14159265f;
@@ -157,9 +161,12 @@ public:
         : maxAcceleration(maxAccel), maxSpeed(maxSpeed),
           wanderOffset(wanderOffset), wanderRadius(wanderRadius),
           wanderRate(wanderRate), timeToTarget(timeToTarget),
-          wanderOrientation(0.f)
+          wanderOrientation(0.f), rng(Rng::agentSeed())
     {}
 
+    /// Restart the wander jitter from a fixed seed.
+    void seed(uint64_t s) { rng.seed(s); }
+
     virtual SteeringOutput getSteering(const Kinematic& character, const Kinematic& , float /*deltaTime*/) override {
         // update wander with random binomial value.
         wanderOrientation += randomBinomial() * wanderRate;
@@ -192,10 +199,11 @@ private:
     float wanderRate;
     float timeToTarget;
     float wanderOrientation;
+    Rng   rng;
 
     
     float randomBinomial() {
-        return ((float)std::rand() / RAND_MAX) - ((float)std::rand() / RAND_MAX);
+        return rng.unit() - rng.unit();
     }
 };
 
@@ -261,29 +269,90 @@ public:
         : flock(flock), neighborRadius(neighborRadius), separationRadius(separationRadius),
           separationWeight(separationWeight), alignmentWeight(alignmentWeight), cohesionWeight(cohesionWeight),
           maxAcceleration(maxAcceleration),
-          wander(wanderMaxAccel, wanderMaxSpeed, wanderOffset, wanderRadius, wanderRate, wanderTimeToTarget)
+          wander(wanderMaxAccel, wanderMaxSpeed, wanderOffset, wanderRadius, wanderRate, wanderTimeToTarget),
+          grid(neighborRadius), gridBuilt(false)
     {}
 
     virtual SteeringOutput getSteering(const Kinematic& character, const Kinematic& /*unused*/, float deltaTime) override {
-        sf::Vector2f separation(0.f, 0.f);
-        sf::Vector2f alignment(0.f, 0.f);
-        sf::Vector2f cohesion(0.f, 0.f);
-        int count = 0;
-        for (const auto& other : *flock) {
-            if (&other == &character)
-                continue;
-            sf::Vector2f toOther = other.position - character.position;
-            float distance = vectorLength(toOther);
-            if (distance < neighborRadius && distance > 0.f) {
-                alignment += other.velocity;
-                cohesion += other.position;
-                count++;
-                if (distance < separationRadius) {
-                    separation += (character.position - other.position) / distance;
-                }
-            }
+        // character may or may not be a member of the flock
+        const Kinematic* first = flock->data();
+        const Kinematic* last  = first + flock->size();
+        int self = -1;
+        if (!std::less<const Kinematic*>()(&character, first) &&
+            std::less<const Kinematic*>()(&character, last))
+            self = static_cast<int>(&character - first);
+        return steerBoid(character, self, deltaTime);
+    }
+
+    // Steers the whole flock at once: out[i] is the steering for (*flock)[i].
+    // Bins the flock into the neighbor grid first and only trusts it for this
+    // call; getSteering always scans the whole flock, since the boids may
+    // have moved since.
+    void steerFlock(std::vector<SteeringOutput>& out, float deltaTime) {
+        rebuildNeighbors();
+        out.resize(flock->size());
+        for (size_t i = 0; i < flock->size(); ++i)
+            out[i] = steerBoid((*flock)[i], static_cast<int>(i), deltaTime);
+        gridBuilt = false;
+    }
+
+private:
+    const std::vector<Kinematic>* flock;
+    float neighborRadius;
+    float separationRadius;
+    float separationWeight;
+    float alignmentWeight;
+    float cohesionWeight;
+    float maxAcceleration;
+    WanderBehavior wander;
+
+    SpatialHash               grid;       // cell size == neighborRadius
+    std::vector<sf::Vector2f> positions;  // positions the grid was built from
+    bool                      gridBuilt;  // only during steerFlock
+    std::vector<float>        nbX, nbY, nbVX, nbVY;  // per-query neighbor scratch (SoA)
+
+    void rebuildNeighbors() {
+        positions.resize(flock->size());
+        for (size_t i = 0; i < flock->size(); ++i)
+            positions[i] = (*flock)[i].position;
+        grid.rebuild(positions.data(), positions.size());
+        gridBuilt = true;
+    }
+
+    // self is the character's index in the flock (-1 if it isn't in it)
+    SteeringOutput steerBoid(const Kinematic& character, int self, float deltaTime) {
+        // gather candidate neighbors into SoA scratch for the SIMD kernel
+        if (nbX.size() < flock->size()) {
+            nbX.resize(flock->size()); nbY.resize(flock->size());
+            nbVX.resize(flock->size()); nbVY.resize(flock->size());
         }
-        
+        int n = 0;
+        auto gather = [&](int j) {
+            if (j == self)
+                return;
+            const Kinematic& other = (*flock)[j];
+            nbX[n]  = other.position.x;
+            nbY[n]  = other.position.y;
+            nbVX[n] = other.velocity.x;
+            nbVY[n] = other.velocity.y;
+            ++n;
+        };
+        if (gridBuilt && grid.size() == flock->size()) {
+            grid.forEachNear(character.position, neighborRadius, gather);
+        } else {
+            for (int j = 0; j < static_cast<int>(flock->size()); ++j)
+                gather(j);
+        }
+        FlockSums sums = accumulateFlock(nbX.data(), nbY.data(),
+                                         nbVX.data(), nbVY.data(),
+                                         n,
+                                         character.position.x, character.position.y,
+                                         neighborRadius, separationRadius);
+        sf::Vector2f separation(sums.separationX, sums.separationY);
+        sf::Vector2f alignment(sums.alignmentX, sums.alignmentY);
+        sf::Vector2f cohesion(sums.cohesionX, sums.cohesionY);
+        int count = sums.count;
+
         SteeringOutput steering;
         if (count == 0) {
             // If no neighbors, use wander
@@ -303,16 +372,6 @@ public:
         steering.angular = 0.f;
         return steering;
     }
-
-private:
-    const std::vector<Kinematic>* flock;
-    float neighborRadius;
-    float separationRadius;
-    float separationWeight;
-    float alignmentWeight;
-    float cohesionWeight;
-    float maxAcceleration;
-    WanderBehavior wander;
 };
 
 #endif 
@@ -0,0 +1,101 @@
+// ThreadPool.cpp
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+ThreadPool::ThreadPool(unsigned threads) {
+    if (threads == 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned i = 0; i < threads; ++i)
+        queues_.emplace_back(new Queue());
+    for (unsigned i = 1; i < threads; ++i)
+        workers_.emplace_back(&ThreadPool::run, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : workers_)
+        t.join();
+}
+
+void ThreadPool::parallelFor(std::size_t n, std::size_t grain,
+                             const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (n == 0)
+        return;
+    const std::size_t parts = queues_.size();
+    if (grain == 0)
+        grain = std::max<std::size_t>(1, n / (parts * 4));
+    if (parts == 1 || n <= grain) {
+        body(0, n);
+        return;
+    }
+
+    // count first: a worker still spinning on the last loop may grab a
+    // chunk as soon as it is queued
+    remaining_.store((n + grain - 1) / grain);
+    std::size_t chunk = 0;
+    for (std::size_t b = 0; b < n; b += grain, ++chunk) {
+        Queue& q = *queues_[chunk % parts];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.ranges.push_back({ b, std::min(n, b + grain), &body });
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++epoch_;
+    }
+    wake_.notify_all();
+
+    // help until every chunk is done (the last ones may be running elsewhere)
+    while (remaining_.load() > 0)
+        if (!runOne(0))
+            std::this_thread::yield();
+}
+
+bool ThreadPool::runOne(unsigned self) {
+    Range r;
+    bool found = false;
+    {
+        Queue& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.ranges.empty()) {
+            r = own.ranges.front();
+            own.ranges.pop_front();
+            found = true;
+        }
+    }
+    for (std::size_t k = 1; !found && k < queues_.size(); ++k) {
+        Queue& victim = *queues_[(self + k) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.ranges.empty()) {
+            r = victim.ranges.back();
+            victim.ranges.pop_back();
+            found = true;
+            steals_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!found)
+        return false;
+    (*r.body)(r.begin, r.end);
+    remaining_.fetch_sub(1);
+    return true;
+}
+
+void ThreadPool::run(unsigned self) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&]{ return stopping_ || epoch_ != seen; });
+            if (stopping_)
+                return;
+            seen = epoch_;
+        }
+        while (remaining_.load() > 0)
+            if (!runOne(self))
+                std::this_thread::yield();
+    }
+}
@@ -0,0 +1,66 @@
+// ThreadPool.hpp
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include <cstddef>
+
+/// Fork/join pool for per‐frame data‐parallel loops. parallelFor() cuts
+/// [0, n) into chunks and deals them round‐robin onto one deque per
+/// participant (the workers plus the calling thread). Each participant pops
+/// from the front of its own deque and, once that is empty, steals from the
+/// back of the others, so a few slow agents don't leave the rest idle.
+/// The call returns when every chunk has run.
+class ThreadPool {
+public:
+    /// threads == 0 uses std::thread::hardware_concurrency(). threads == 1
+    /// starts no workers and runs everything on the caller.
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Participants, counting the calling thread.
+    unsigned size() const { return (unsigned)queues_.size(); }
+
+    /// body(begin, end) for consecutive ranges covering [0, n), at most
+    /// `grain` indices each (0 = a few chunks per participant). Ranges may
+    /// run concurrently and in any order. Not reentrant.
+    void parallelFor(std::size_t n, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& body);
+
+    /// Chunks a participant took from someone else's deque, since construction.
+    std::size_t steals() const { return steals_.load(); }
+
+private:
+    using Body = std::function<void(std::size_t, std::size_t)>;
+    struct Range {
+        std::size_t begin, end;
+        const Body* body;   // per range: a straggler may steal the next loop's
+    };
+    struct Queue {
+        std::mutex        mutex;
+        std::deque<Range> ranges;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;   // [0] is the caller's
+    std::vector<std::thread>            workers_;
+
+    std::mutex              mutex_;
+    std::condition_variable wake_;
+    uint64_t                epoch_    = 0;   // bumped per parallelFor
+    bool                    stopping_ = false;
+
+    std::atomic<std::size_t> remaining_{0};   // chunks not yet finished
+    std::atomic<std::size_t> steals_{0};
+
+    void run(unsigned self);
+    bool runOne(unsigned self);
+};
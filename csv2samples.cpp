@@ -0,0 +1,146 @@
+// csv2samples.cpp
+//
+// Converts monster_data.csv text (room,dist,aggro,wall,action, columns in
+// any order) into a DataRecorder sample file, one line at a time, so a
+// legacy log of any size goes through in constant memory. Lines that don't
+// parse are skipped and counted. samples2csv goes the other way.
+//
+//   ./csv2samples monster_data.csv -o monster_data.bin
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "DataRecorder.hpp"
+
+// splits line at commas in place; returns the field count
+static int splitFields(char* line, char** fields, int maxFields) {
+    int n = 0;
+    fields[n++] = line;
+    for (char* p = line; *p && n < maxFields; ++p)
+        if (*p == ',') {
+            *p = '\0';
+            fields[n++] = p + 1;
+        }
+    return n;
+}
+
+static void trimLineEnd(char* s) {
+    s[std::strcspn(s, "\r\n")] = '\0';
+}
+
+static bool parseInt(const char* s, long lo, long hi, long& v) {
+    char* end;
+    v = std::strtol(s, &end, 10);
+    return end != s && *end == '\0' && v >= lo && v <= hi;
+}
+
+static bool parseSample(char** fields, int nf, const int col[5], Sample& s) {
+    for (int c = 0; c < 5; ++c)
+        if (col[c] >= nf)
+            return false;
+    long  room, aggro, wall;
+    char* end;
+    float dist = std::strtof(fields[col[1]], &end);
+    if (!parseInt(fields[col[0]], 0, 255, room) ||
+        end == fields[col[1]] || *end != '\0' ||
+        !parseInt(fields[col[2]], 0, 1, aggro) ||
+        !parseInt(fields[col[3]], 0, 1, wall) ||
+        !parseAction(fields[col[4]], s.action))
+        return false;
+    s.roomId       = int(room);
+    s.distToPlayer = dist;
+    s.inAggro      = aggro != 0;
+    s.hittingWall  = wall != 0;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* input  = nullptr;
+    const char* output = nullptr;
+    bool        usage  = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-o") && i + 1 < argc)
+            output = argv[++i];
+        else if (argv[i][0] != '-' && !input)
+            input = argv[i];
+        else
+            usage = true;
+    }
+    if (usage || !input || !output) {
+        std::cerr << "usage: csv2samples monster_data.csv -o samples.bin\n";
+        return 1;
+    }
+
+    std::FILE* in = std::fopen(input, "r");
+    if (!in) {
+        std::cerr << "csv2samples: can't read " << input << "\n";
+        return 1;
+    }
+    char*       line = nullptr;
+    std::size_t cap  = 0;
+    char*       fields[16];
+
+    // columns by header name, like csv.DictReader
+    static const char* names[5] = { "room", "dist", "aggro", "wall", "action" };
+    int col[5] = { -1, -1, -1, -1, -1 };
+    if (::getline(&line, &cap, in) > 0) {
+        trimLineEnd(line);
+        int nf = splitFields(line, fields, 16);
+        for (int i = 0; i < nf; ++i)
+            for (int c = 0; c < 5; ++c)
+                if (!std::strcmp(fields[i], names[c]))
+                    col[c] = i;
+    }
+    for (int c = 0; c < 5; ++c)
+        if (col[c] < 0) {
+            std::cerr << "csv2samples: " << input << " has no " << names[c] << " column\n";
+            std::free(line);
+            std::fclose(in);
+            return 1;
+        }
+
+    long long rows = 0, skipped = 0;
+    bool      writeError = false;
+    {
+        // the recorder's writer thread writes while this one parses
+        DataRecorder out(output);
+        if (!out.ok()) {
+            std::cerr << "csv2samples: can't write " << output << "\n";
+            std::free(line);
+            std::fclose(in);
+            return 1;
+        }
+        while (::getline(&line, &cap, in) > 0) {
+            trimLineEnd(line);
+            if (!*line)
+                continue;
+            Sample s;
+            if (parseSample(fields, splitFields(line, fields, 16), col, s)) {
+                out.record(s);
+                ++rows;
+            } else {
+                ++skipped;
+            }
+        }
+        out.close();
+        writeError = !out.ok();
+    }
+    bool readError = std::ferror(in);
+    std::free(line);
+    std::fclose(in);
+    if (writeError) {
+        std::cerr << "csv2samples: write to " << output << " failed\n";
+        return 1;
+    }
+    if (readError) {
+        std::cerr << "csv2samples: error reading " << input << "\n";
+        return 1;
+    }
+    std::cerr << "csv2samples: " << rows << " samples";
+    if (skipped)
+        std::cerr << ", " << skipped << " unparseable lines skipped";
+    std::cerr << "\n";
+    return 0;
+}
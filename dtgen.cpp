@@ -0,0 +1,228 @@
+// dtgen.cpp
+//
+// Loads a learn_dt.py tree (JSON), compiles it to a LearnedDecisionTree and
+// optionally
+//   --emit out.cpp   writes it as a C++ function (nested ifs / switches) to
+//                    link into the build, e.g. for
+//                    DecisionTreeController(LearnedTreeFn);
+//   --bench samples  checks the compiled tree against a walk of the JSON on
+//                    every row of a monster_data.csv‐style file and times
+//                    both.
+//
+//   ./dtgen tree.json [--emit out.cpp] [--name fn] [--bench monster_data.csv]
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <nlohmann/json.hpp>
+
+#include "LearnedDecisionTree.hpp"
+
+// ——— code generation ———————————————————————————————————————————————
+
+static void indentTo(std::ostream& out, int depth) {
+    for (int i = 0; i < depth; ++i) out << "    ";
+}
+
+static void emitNode(std::ostream& out, const LearnedDecisionTree& tree,
+                     int32_t index, int depth)
+{
+    using Feature = LearnedDecisionTree::Feature;
+    const auto& n = tree.nodes()[index];
+    const auto& children = tree.children();
+    if (n.count == 0) {
+        indentTo(out, depth);
+        out << "return MonsterAction::" << (n.label == MonsterAction::Chase ? "Chase"
+                                         : n.label == MonsterAction::Reset ? "Reset"
+                                         :                                   "Wander")
+            << ";\n";
+        return;
+    }
+    if (n.feature == Feature::Dist) {
+        // hexfloat: the literal is exactly the threshold that was compiled
+        char lit[64];
+        std::snprintf(lit, sizeof(lit), "%af", n.thresh);
+        indentTo(out, depth);
+        out << "if (f.dist <= " << lit << ") {   // " << n.thresh << "\n";
+        emitNode(out, tree, children[n.first], depth + 1);
+        indentTo(out, depth);
+        out << "} else {\n";
+        emitNode(out, tree, children[n.first + 1], depth + 1);
+        indentTo(out, depth);
+        out << "}\n";
+        return;
+    }
+    indentTo(out, depth);
+    out << "switch ((int)f." << LearnedDecisionTree::featureName(n.feature) << ") {\n";
+    for (int v = 0; v < n.count; ++v) {
+        if (children[n.first + v] < 0)
+            continue;
+        indentTo(out, depth);
+        out << "case " << v << ":\n";
+        emitNode(out, tree, children[n.first + v], depth + 1);
+    }
+    indentTo(out, depth);
+    out << "default:\n";
+    indentTo(out, depth + 1);
+    out << "return MonsterAction::"
+        << (tree.fallback() == MonsterAction::Chase ? "Chase"
+          : tree.fallback() == MonsterAction::Reset ? "Reset" : "Wander")
+        << ";   // value never seen in training\n";
+    indentTo(out, depth);
+    out << "}\n";
+}
+
+static bool emit(const LearnedDecisionTree& tree, const std::string& source,
+                 const std::string& path, const std::string& name)
+{
+    std::ofstream out(path);
+    if (!out)
+        return false;
+    out << "// " << path << "\n"
+        << "// Generated by dtgen from " << source << "; do not edit.\n\n"
+        << "#include \"MonsterAction.hpp\"\n\n"
+        << "MonsterAction " << name << "(const MonsterFeatures& f) {\n";
+    emitNode(out, tree, 0, 1);
+    out << "}\n";
+    return bool(out);
+}
+
+// ——— bench ——————————————————————————————————————————————————————————
+
+struct Row {
+    MonsterFeatures f;
+    MonsterAction   action;
+};
+
+static bool loadSamples(const std::string& path, std::vector<Row>& rows) {
+    std::ifstream in(path);
+    std::string line;
+    if (!in || !std::getline(in, line))
+        return false;
+    while (std::getline(in, line)) {
+        Row r;
+        int aggro = 0, wall = 0;
+        char action[32];
+        if (std::sscanf(line.c_str(), "%d,%f,%d,%d,%31s",
+                        &r.f.room, &r.f.dist, &aggro, &wall, action) != 5 ||
+            !parseAction(action, r.action))
+            continue;
+        r.f.aggro = aggro != 0;
+        r.f.wall  = wall != 0;
+        rows.push_back(r);
+    }
+    return true;
+}
+
+// the per‐frame JSON walk DecisionTreeController used to do (with a
+// missing branch mapped to Wander, like the compiled tree's fallback)
+static std::string walkJson(const nlohmann::json& node, const MonsterFeatures& f) {
+    if (node.contains("label"))
+        return node["label"];
+    auto a = node["attr"].get<std::string>();
+    if (a == "dist")
+        return walkJson(f.dist <= node["thresh"].get<float>() ? node["le"] : node["gt"], f);
+    int v = a == "room" ? f.room : a == "aggro" ? f.aggro : f.wall;
+    auto key = std::to_string(v);
+    if (!node["branches"].contains(key))
+        return "wander";
+    return walkJson(node["branches"][key], f);
+}
+
+static volatile unsigned gSink;   // keeps the timed loops from being dropped
+
+static void bench(const nlohmann::json& json, const LearnedDecisionTree& tree,
+                  const std::vector<Row>& rows)
+{
+    using clock = std::chrono::steady_clock;
+    const int reps = std::max<std::size_t>(1, 2000000 / std::max<std::size_t>(1, rows.size()));
+
+    long mismatches = 0, correct = 0;
+    for (const Row& r : rows) {
+        MonsterAction c = tree.evaluate(r.f);
+        MonsterAction j = tree.fallback();
+        parseAction(walkJson(json, r.f).c_str(), j);
+        mismatches += c != j;
+        correct    += c == r.action;
+    }
+
+    unsigned sink = 0;
+    auto t0 = clock::now();
+    for (const Row& r : rows)
+        sink += walkJson(json, r.f).size();
+    double jsonNs = std::chrono::duration<double, std::nano>(clock::now() - t0).count()
+                  / rows.size();
+    t0 = clock::now();
+    for (int k = 0; k < reps; ++k)
+        for (const Row& r : rows)
+            sink += unsigned(tree.evaluate(r.f));
+    double compiledNs = std::chrono::duration<double, std::nano>(clock::now() - t0).count()
+                      / (double(rows.size()) * reps);
+
+    std::cout << "samples:           " << rows.size() << "\n"
+              << "compiled vs json:  " << mismatches << " mismatches\n"
+              << "training accuracy: " << 100.0 * correct / rows.size() << " %\n"
+              << "json walk:         " << jsonNs << " ns/eval\n"
+              << "compiled:          " << compiledNs << " ns/eval\n";
+    gSink = sink;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: dtgen tree.json [--emit out.cpp] [--name fn] [--bench samples.csv]\n";
+        return 1;
+    }
+    std::string treePath = argv[1], emitPath, benchPath, name = "learnedMonsterTree";
+    for (int i = 2; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if      (!std::strcmp(argv[i], "--emit")  && hasValue) emitPath  = argv[++i];
+        else if (!std::strcmp(argv[i], "--name")  && hasValue) name      = argv[++i];
+        else if (!std::strcmp(argv[i], "--bench") && hasValue) benchPath = argv[++i];
+        else {
+            std::cerr << "dtgen: unknown argument " << argv[i] << "\n";
+            return 1;
+        }
+    }
+
+    std::ifstream in(treePath);
+    if (!in) {
+        std::cerr << "dtgen: can't open " << treePath << "\n";
+        return 1;
+    }
+    nlohmann::json json = nlohmann::json::parse(in, nullptr, /*allow_exceptions=*/false);
+    if (json.is_discarded()) {
+        std::cerr << "dtgen: " << treePath << " is not valid JSON\n";
+        return 1;
+    }
+    LearnedDecisionTree tree;
+    std::string error;
+    if (!tree.compile(json, &error)) {
+        std::cerr << "dtgen: " << treePath << ": " << error << "\n";
+        return 1;
+    }
+    std::cout << "compiled:          " << tree.nodes().size() << " nodes, "
+              << tree.children().size() << " child slots\n";
+
+    if (!emitPath.empty()) {
+        if (!emit(tree, treePath, emitPath, name)) {
+            std::cerr << "dtgen: can't write " << emitPath << "\n";
+            return 1;
+        }
+        std::cout << "wrote:             " << emitPath << " (" << name << ")\n";
+    }
+    if (!benchPath.empty()) {
+        std::vector<Row> rows;
+        if (!loadSamples(benchPath, rows) || rows.empty()) {
+            std::cerr << "dtgen: no samples in " << benchPath << "\n";
+            return 1;
+        }
+        bench(json, tree, rows);
+    }
+    return 0;
+}
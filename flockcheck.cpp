@@ -0,0 +1,195 @@
+// flockcheck.cpp
+//
+// Holds every accumulateFlock path this machine can run (AVX2, SSE2,
+// scalar, and whichever one the build picked) against the per‐neighbor
+// loop FlockingBehavior::steerBoid ran before the kernel existed. Flocks
+// are random, then built to hit the edges: boids stacked on the same spot
+// (distance 0, never neighbors), boids exactly on neighborRadius and
+// separationRadius, and sizes around every lane width so the scalar tails
+// run too. Neighbor counts must agree exactly, the sums within epsilon.
+// Exits 1 on any mismatch.
+//
+//   ./flockcheck [--trials N] [--seed S]
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+#include "Steering.hpp"
+#include "FlockKernel.hpp"
+
+static const float kNeighborRadius   = 50.f;
+static const float kSeparationRadius = 20.f;
+static const float kEpsilon          = 1e-4f;   // relative, on each sum
+
+typedef FlockSums (*FlockKernelFn)(const float*, const float*, const float*,
+                                   const float*, int, float, float, float, float);
+
+struct KernelPath {
+    const char*   name;
+    FlockKernelFn fn;
+    double        worst  = 0.0;   // largest relative error seen
+    long long     bad    = 0;     // boids outside epsilon or miscounted
+};
+
+// the pre‐kernel steerBoid neighbor loop, verbatim apart from the flock
+// scan (the grid only narrows the candidates)
+static FlockSums perNeighborLoop(const std::vector<Kinematic>& flock, int self) {
+    const Kinematic& character = flock[self];
+    sf::Vector2f separation(0.f, 0.f);
+    sf::Vector2f alignment(0.f, 0.f);
+    sf::Vector2f cohesion(0.f, 0.f);
+    int count = 0;
+    for (int j = 0; j < static_cast<int>(flock.size()); ++j) {
+        if (j == self)
+            continue;
+        const Kinematic& other = flock[j];
+        sf::Vector2f toOther = other.position - character.position;
+        float distance = vectorLength(toOther);
+        if (distance < kNeighborRadius && distance > 0.f) {
+            alignment += other.velocity;
+            cohesion += other.position;
+            count++;
+            if (distance < kSeparationRadius) {
+                separation += (character.position - other.position) / distance;
+            }
+        }
+    }
+    FlockSums s;
+    s.separationX = separation.x; s.separationY = separation.y;
+    s.alignmentX  = alignment.x;  s.alignmentY  = alignment.y;
+    s.cohesionX   = cohesion.x;   s.cohesionY   = cohesion.y;
+    s.count       = count;
+    return s;
+}
+
+static double relativeError(float got, float want) {
+    return std::fabs(double(got) - double(want)) / std::max(1.0, std::fabs(double(want)));
+}
+
+static double worstError(const FlockSums& got, const FlockSums& want) {
+    double e = 0.0;
+    e = std::max(e, relativeError(got.separationX, want.separationX));
+    e = std::max(e, relativeError(got.separationY, want.separationY));
+    e = std::max(e, relativeError(got.alignmentX,  want.alignmentX));
+    e = std::max(e, relativeError(got.alignmentY,  want.alignmentY));
+    e = std::max(e, relativeError(got.cohesionX,   want.cohesionX));
+    e = std::max(e, relativeError(got.cohesionY,   want.cohesionY));
+    return e;
+}
+
+// every boid against the rest, the way steerBoid gathers them
+static void checkFlock(const std::vector<Kinematic>& flock, std::vector<KernelPath>& paths) {
+    std::vector<float> nbX, nbY, nbVX, nbVY;
+    for (int self = 0; self < static_cast<int>(flock.size()); ++self) {
+        nbX.clear(); nbY.clear(); nbVX.clear(); nbVY.clear();
+        for (int j = 0; j < static_cast<int>(flock.size()); ++j) {
+            if (j == self)
+                continue;
+            nbX.push_back(flock[j].position.x);
+            nbY.push_back(flock[j].position.y);
+            nbVX.push_back(flock[j].velocity.x);
+            nbVY.push_back(flock[j].velocity.y);
+        }
+        const sf::Vector2f c = flock[self].position;
+        FlockSums want = perNeighborLoop(flock, self);
+        for (KernelPath& p : paths) {
+            FlockSums got = p.fn(nbX.data(), nbY.data(), nbVX.data(), nbVY.data(),
+                                 static_cast<int>(nbX.size()), c.x, c.y,
+                                 kNeighborRadius, kSeparationRadius);
+            double e = worstError(got, want);
+            p.worst = std::max(p.worst, e);
+            if (got.count != want.count || !(e <= kEpsilon))
+                ++p.bad;
+        }
+    }
+}
+
+static Kinematic boidAt(float x, float y, std::mt19937& rng) {
+    std::uniform_real_distribution<float> vel(-10.f, 10.f);
+    Kinematic k;
+    k.position    = sf::Vector2f(x, y);
+    k.velocity    = sf::Vector2f(vel(rng), vel(rng));
+    k.orientation = 0.f;
+    k.rotation    = 0.f;
+    return k;
+}
+
+int main(int argc, char** argv) {
+    int      trials = 200;
+    unsigned seed   = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--trials") && i + 1 < argc)
+            trials = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        else {
+            std::cerr << "usage: flockcheck [--trials N] [--seed S]\n";
+            return 1;
+        }
+    }
+
+    std::vector<KernelPath> paths;
+    paths.push_back({ "accumulateFlock", accumulateFlock });
+    paths.push_back({ "scalar", accumulateFlockScalar });
+#if FLOCK_KERNEL_X86
+    paths.push_back({ "sse2", accumulateFlockSSE2 });
+    if (flockKernelHasAVX2())
+        paths.push_back({ "avx2", accumulateFlockAVX2 });
+    else
+        std::cout << "avx2: not supported by this CPU, skipped\n";
+#endif
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(0.f, 150.f);
+    std::uniform_real_distribution<float> angle(0.f, 6.2831853f);
+    long long boids = 0;
+    for (int t = 0; t < trials; ++t) {
+        // 1..40 boids, so every lane count and tail length turns up
+        const int n = 1 + t % 40;
+        std::vector<Kinematic> flock;
+
+        // random
+        for (int i = 0; i < n; ++i)
+            flock.push_back(boidAt(coord(rng), coord(rng), rng));
+        checkFlock(flock, paths);
+        boids += flock.size();
+
+        // a few stacks of coincident boids, plus some exactly on either
+        // radius of a stack (axis‐aligned, so the distance is exact)
+        flock.clear();
+        for (int i = 0; i < n; ++i) {
+            float x = std::floor(coord(rng) / 30.f) * 30.f;   // few distinct spots
+            float y = std::floor(coord(rng) / 30.f) * 30.f;
+            switch (i % 4) {
+            case 0: flock.push_back(boidAt(x, y, rng)); break;
+            case 1: flock.push_back(boidAt(x + kNeighborRadius, y, rng)); break;
+            case 2: flock.push_back(boidAt(x, y - kSeparationRadius, rng)); break;
+            default: {
+                // just inside the separation radius, any direction
+                float a = angle(rng), r = kSeparationRadius * 0.999f;
+                flock.push_back(boidAt(x + r * std::cos(a), y + r * std::sin(a), rng));
+            }
+            }
+        }
+        checkFlock(flock, paths);
+        boids += flock.size();
+    }
+
+    bool failed = false;
+    std::cout << boids << " boids over " << trials * 2 << " flocks, epsilon " << kEpsilon << "\n";
+    for (const KernelPath& p : paths) {
+        std::cout << p.name << ": worst relative error " << p.worst;
+        if (p.bad) {
+            std::cout << ", " << p.bad << " boids out of tolerance or miscounted";
+            failed = true;
+        }
+        std::cout << "\n";
+    }
+    return failed ? 1 : 0;
+}
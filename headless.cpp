@@ -0,0 +1,556 @@
+// headless.cpp
+//
+// Runs the part3 player/monster simulation without a window: no texture,
+// no draw calls, and a fixed synthetic dt instead of sf::Clock::restart().
+// Useful for generating monster_data‐style samples and for regression runs
+// on machines without a display.
+//
+//   ./headless [--seconds S] [--dt D] [--monsters N] [--routes] [--flowfield]
+//              [--incremental] [--hpa] [--distfield]
+//              [--budget EXPANSIONS] [--async-paths THREADS] [--threads T]
+//              [--seed S] [--check-parallel] [--wallclock]
+//              [--record run.sjnl | --replay run.sjnl] [--checksum-every N]
+//              [--flat-bt] [--samples out.bin]
+//
+// --flat-bt gives every monster the shared flat behavior tree instead of
+// its own tree of BTNode objects (same behavior, so it may be replayed
+// either way).
+//
+// --threads ticks the monsters on a work‐stealing pool; --check-parallel
+// also runs a serial copy of the same world in lockstep and reports the
+// first frame where the two differ. With --flowfield it also fails if
+// either copy built more flow fields than the player changed nodes, i.e.
+// if monsters stopped sharing them.
+//
+// --wallclock steps by the real time each frame took, like part3, instead
+// of a fixed dt. --record journals the run (seed, options, every dt and a
+// world checksum every N frames); --replay reruns a journal with its own
+// options and reports the first checksum that doesn't match.
+//
+// --samples records one Sample per monster per frame in DataRecorder's
+// binary format; samples2csv turns it into monster_data.csv text.
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+#include "Node.hpp"            // for Node, extern graphNodes
+#include "Environment.hpp"     // for drawSymmetricRoomLayout, createGraphGrid, getRoomId
+#include "Steering.hpp"        // for Kinematic, vectorLength, mapToRange
+#include "BehaviorController.hpp"
+#include "MonsterController.hpp"
+#include "MonsterBehaviorFactory.hpp"
+#include "DataRecorder.hpp"    // for Sample, DataRecorder
+#include "AgentStore.hpp"
+#include "RoutingTable.hpp"
+#include "FlowField.hpp"
+#include "HierarchicalPlanner.hpp"
+#include "CollisionGrid.hpp"
+#include "DistanceField.hpp"
+#include "PathScheduler.hpp"
+#include "AsyncPathService.hpp"
+#include "ThreadPool.hpp"
+#include "Rng.hpp"
+#include "SimJournal.hpp"
+#include <sstream>
+#include <string>
+#include <climits>
+
+struct HeadlessOptions {
+    float       seconds = 60.f;      // simulated time to run
+    float       dt      = 1.f/60.f;  // fixed step per frame
+    int         monsters = 1;        // all chasing the one player
+    bool        routes  = false;     // chase with a precomputed next‐hop table
+    bool        incremental = false; // chase with D* Lite
+    bool        flowField = false;   // chase by one shared flow field
+    bool        hpa     = false;     // wander with HPA* over the four rooms
+    bool        distField = false;   // player senses walls via a distance field
+    int         budget  = 0;         // >0: queue A* with this many expansions/frame
+    int         asyncThreads = -1;   // >=0: A* on worker threads (0 = all cores)
+    int         threads = -1;        // >=0: tick monsters on a pool (0 = all cores)
+    uint64_t    seed    = 1;         // run seed; agent i draws from seed + 1 + i
+    bool        checkParallel = false; // compare against a serial copy each frame
+    bool        wallclock = false;   // dt = real frame time instead of `dt`
+    const char* recordPath = nullptr; // journal the run here
+    const char* replayPath = nullptr; // rerun this journal
+    int         checksumEvery = 60;  // frames between journal checksums
+    bool        flatTree = false;    // one shared FlatBehaviorTree for all monsters
+    const char* samplesPath = nullptr;   // record samples here if set
+};
+
+static void printUsage() {
+    std::cerr << "usage: headless [--seconds S] [--dt D] [--monsters N]"
+                 " [--routes] [--flowfield] [--incremental] [--hpa] [--distfield]"
+                 " [--budget EXPANSIONS] [--async-paths THREADS] [--threads T]"
+                 " [--seed S] [--check-parallel] [--wallclock]"
+                 " [--record run.sjnl | --replay run.sjnl] [--checksum-every N]"
+                 " [--flat-bt] [--samples out.bin]\n";
+}
+
+static bool validOptions(const HeadlessOptions& opt);
+
+static bool parseArgs(int argc, char** argv, HeadlessOptions& opt) {
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--seconds") && hasValue)
+            opt.seconds = std::strtof(argv[++i], nullptr);
+        else if (!std::strcmp(argv[i], "--dt") && hasValue)
+            opt.dt = std::strtof(argv[++i], nullptr);
+        else if (!std::strcmp(argv[i], "--monsters") && hasValue)
+            opt.monsters = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--routes"))
+            opt.routes = true;
+        else if (!std::strcmp(argv[i], "--flowfield"))
+            opt.flowField = true;
+        else if (!std::strcmp(argv[i], "--incremental"))
+            opt.incremental = true;
+        else if (!std::strcmp(argv[i], "--hpa"))
+            opt.hpa = true;
+        else if (!std::strcmp(argv[i], "--distfield"))
+            opt.distField = true;
+        else if (!std::strcmp(argv[i], "--budget") && hasValue)
+            opt.budget = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--async-paths") && hasValue)
+            opt.asyncThreads = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--threads") && hasValue)
+            opt.threads = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && hasValue)
+            opt.seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--check-parallel"))
+            opt.checkParallel = true;
+        else if (!std::strcmp(argv[i], "--wallclock"))
+            opt.wallclock = true;
+        else if (!std::strcmp(argv[i], "--record") && hasValue)
+            opt.recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--replay") && hasValue)
+            opt.replayPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--checksum-every") && hasValue)
+            opt.checksumEvery = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--flat-bt"))
+            opt.flatTree = true;
+        else if (!std::strcmp(argv[i], "--samples") && hasValue)
+            opt.samplesPath = argv[++i];
+        else
+            return false;
+    }
+    if (opt.checkParallel && opt.threads < 0)
+        opt.threads = 0;
+    return validOptions(opt);
+}
+
+static bool validOptions(const HeadlessOptions& opt) {
+    // these services are shared between monsters and single threaded, and
+    // async results depend on timing (flow fields lock, see FlowFieldService)
+    if (opt.threads >= 0 && (opt.hpa || opt.budget > 0 ||
+                             (opt.checkParallel && opt.asyncThreads >= 0)))
+        return false;
+    // a journal only holds dts, so nothing in the run may depend on timing
+    if ((opt.recordPath || opt.replayPath) && opt.asyncThreads >= 0)
+        return false;
+    if (opt.recordPath && opt.replayPath)
+        return false;
+    return opt.seconds > 0.f && opt.dt > 0.f && opt.monsters > 0;
+}
+
+// same integration + wall clamp as the part3 player update
+static void stepPlayer(Kinematic& player, BehaviorController& ctrl,
+                       const CollisionGrid& collision, float dt)
+{
+    SteeringOutput ps = ctrl.update(player, dt);
+    player.velocity += ps.linear * dt;
+    sf::Vector2f prev = player.position;
+    player.position += player.velocity * dt;
+    if (collision.blocked(player.position)) {
+        player.position = prev;
+        player.velocity = {0.f,0.f};
+    }
+    player.rotation    += ps.angular * dt;
+    player.orientation += player.rotation * dt;
+    player.orientation  = mapToRange(player.orientation);
+}
+
+// options that change what the simulation does, as journaled with --record
+static std::string journalConfig(const HeadlessOptions& opt) {
+    std::ostringstream c;
+    c << "--monsters " << opt.monsters;
+    if (opt.routes)      c << " --routes";
+    if (opt.incremental) c << " --incremental";
+    if (opt.flowField)   c << " --flowfield";
+    if (opt.hpa)         c << " --hpa";
+    if (opt.distField)   c << " --distfield";
+    if (opt.budget > 0)  c << " --budget " << opt.budget;
+    return c.str();
+}
+
+// --replay: the journal's options replace the command line's, except for
+// the ones that only change how the run is executed or reported
+static bool loadJournal(SimJournal& journal, HeadlessOptions& opt) {
+    if (!journal.replay(opt.replayPath)) {
+        std::cerr << "headless: " << opt.replayPath << " is not a journal\n";
+        return false;
+    }
+    std::istringstream words(journal.config());
+    std::vector<std::string> args{ "headless" };
+    for (std::string w; words >> w; )
+        args.push_back(w);
+    std::vector<char*> argv;
+    for (auto& a : args)
+        argv.push_back(&a[0]);
+
+    HeadlessOptions recorded;
+    if (!parseArgs((int)argv.size(), argv.data(), recorded)) {
+        std::cerr << "headless: bad options in journal: " << journal.config() << "\n";
+        return false;
+    }
+    recorded.seed          = journal.seed();
+    recorded.replayPath    = opt.replayPath;
+    recorded.threads       = opt.threads;
+    recorded.checkParallel = opt.checkParallel;
+    recorded.samplesPath   = opt.samplesPath;
+    recorded.flatTree      = opt.flatTree;
+    opt = recorded;
+    return validOptions(opt);
+}
+
+// everything a replay has to reproduce: player and every monster
+static uint64_t worldChecksum(const Kinematic& player, const AgentStore& monsters) {
+    uint64_t h = SimJournal::hash(player);
+    std::size_t n = monsters.size();
+    h = SimJournal::hash(monsters.positions(),    n * sizeof(sf::Vector2f), h);
+    h = SimJournal::hash(monsters.velocities(),   n * sizeof(sf::Vector2f), h);
+    h = SimJournal::hash(monsters.orientations(), n * sizeof(float), h);
+    h = SimJournal::hash(monsters.rotations(),    n * sizeof(float), h);
+    return h;
+}
+
+// monster 0 starts where part3's does, the rest spread over the graph;
+// monster i draws from seed + 1 + i
+static void spawnMonsters(AgentStore& monsters, std::vector<MonsterController*>& ctrls,
+                          int count, const Kinematic& player,
+                          const std::vector<sf::RectangleShape>& walls,
+                          const HeadlessOptions& opt, uint64_t seed,
+                          const FlatBehaviorTree* flat)
+{
+    monsters.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        int n = (int)graphNodes.size();
+        int start = n - 1 - (i * 37) % n;
+        Kinematic m{ graphNodes[start].position, {0,0}, 0.f, 0.f };
+        monsters.add(m);
+        if (flat)
+            ctrls.push_back(new MonsterController(
+                *flat, graphNodes, walls,
+                m.position, player.position,
+                /*eatRadius=*/30.f
+            ));
+        else
+            ctrls.push_back(new MonsterController(
+                graphNodes, walls,
+                m.position, player.position,
+                /*eatRadius=*/30.f
+            ));
+        ctrls.back()->seed(seed + 1 + i);
+        ctrls.back()->setIncrementalChase(opt.incremental);
+    }
+}
+
+static bool sameAgents(const AgentStore& a, const AgentStore& b) {
+    for (std::size_t i = 0; i < a.size(); ++i)
+        if (a.positions()[i] != b.positions()[i] ||
+            a.velocities()[i] != b.velocities()[i] ||
+            a.orientations()[i] != b.orientations()[i] ||
+            a.rotations()[i] != b.rotations()[i])
+            return false;
+    return true;
+}
+
+static Sample makeSample(const Kinematic& monster, const Kinematic& player,
+                         const MonsterController& ctrl,
+                         const CollisionGrid& collision)
+{
+    Sample s;
+    s.roomId       = getRoomId(monster.position);
+    s.distToPlayer = vectorLength(player.position - monster.position);
+    s.inAggro      = (s.distToPlayer < 400.f);
+    sf::Vector2f probe = monster.position +
+        sf::Vector2f(std::cos(monster.orientation),
+                     std::sin(monster.orientation)) * 10.f;
+    s.hittingWall  = collision.blocked(probe);
+    s.action       = ctrl.getLastAction();
+    return s;
+}
+
+int main(int argc, char** argv) {
+    HeadlessOptions opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage();
+        return 1;
+    }
+    SimJournal journal;
+    if (opt.replayPath && !loadJournal(journal, opt))
+        return 1;
+    if (opt.recordPath &&
+        !journal.record(opt.recordPath, opt.seed, journalConfig(opt),
+                        (uint32_t)std::max(0, opt.checksumEvery))) {
+        std::cerr << "headless: can't write " << opt.recordPath << "\n";
+        return 1;
+    }
+
+    // 1) environment (no window)
+    std::vector<sf::RectangleShape> walls;
+    drawSymmetricRoomLayout(walls);
+    GraphBuildStats build;
+    createGraphGrid(graphNodes, walls, 24, 640, 480, &build);
+    CollisionGrid collision;
+    collision.build(walls);
+
+    // 2) player + monster, set up exactly like part3
+    const uint64_t seed = opt.seed;
+    Rng::seedAgents(seed);
+    Kinematic player{ graphNodes[0].position, {0,0}, 0.f, 0.f };
+    BehaviorController playerCtrl(graphNodes, walls);
+    playerCtrl.seed(seed);
+    playerCtrl.initialize(player);
+
+    DistanceField distField;
+    if (opt.distField) {
+        distField.build(walls);
+        distField.report(std::cout);
+        playerCtrl.setDistanceField(&distField);
+    }
+
+    FlatBehaviorTree flatTree = MonsterBehaviorFactory::buildFlatTree();
+    const FlatBehaviorTree* flat = opt.flatTree ? &flatTree : nullptr;
+    AgentStore monsters;
+    std::vector<MonsterController*> monsterCtrls;
+    auto spawnStart = std::chrono::steady_clock::now();
+    spawnMonsters(monsters, monsterCtrls, opt.monsters, player, walls, opt, seed, flat);
+    double spawnMs = std::chrono::duration<double, std::milli>(
+                         std::chrono::steady_clock::now() - spawnStart).count();
+
+    RoutingTable routes;
+    if (opt.routes) {
+        if (routes.build(graphNodes)) {
+            routes.report(std::cout);
+            for (auto* c : monsterCtrls)
+                c->setRoutingTable(&routes);
+        } else {
+            std::cout << "routing table:     " << graphNodes.size()
+                      << " nodes don't fit, chasing with A*\n";
+        }
+    }
+
+    HierarchicalPlanner hpa;
+    if (opt.hpa) {
+        hpa.build(graphNodes, getRoomId);
+        std::cout << "hpa: " << hpa.regionCount() << " regions, "
+                  << hpa.entranceNodes() << " entrance nodes, "
+                  << hpa.abstractEdges() << " abstract edges, built in "
+                  << hpa.buildSeconds() * 1000.0 << " ms\n";
+    }
+
+    FlowFieldService flowFields;
+    for (auto* c : monsterCtrls) {
+        if (opt.flowField)
+            c->setFlowFields(&flowFields);
+        if (opt.hpa)
+            c->setHierarchicalPlanner(&hpa);
+    }
+
+    PathScheduler scheduler(opt.budget);
+    if (opt.budget > 0)
+        for (auto* c : monsterCtrls)
+            c->setPathScheduler(&scheduler);
+
+    std::unique_ptr<AsyncPathService> asyncPaths;
+    if (opt.asyncThreads >= 0) {
+        asyncPaths.reset(new AsyncPathService(snapshotNavGraph(), (unsigned)opt.asyncThreads));
+        std::cout << "async paths:       " << asyncPaths->threads() << " worker threads\n";
+        playerCtrl.setAsyncPaths(asyncPaths.get());
+        for (auto* c : monsterCtrls)
+            c->setAsyncPaths(asyncPaths.get());
+    }
+    std::unique_ptr<ThreadPool> pool;
+    if (opt.threads >= 0) {
+        pool.reset(new ThreadPool((unsigned)opt.threads));
+        std::cout << "monster threads:   " << pool->size() << "\n";
+    }
+
+    // serial copy of the same world, stepped in lockstep for --check-parallel
+    Kinematic shadowPlayer = player;
+    BehaviorController shadowPlayerCtrl(graphNodes, walls);
+    AgentStore shadowMonsters;
+    std::vector<MonsterController*> shadowCtrls;
+    FlowFieldService shadowFlowFields;
+    if (opt.checkParallel) {
+        shadowPlayerCtrl.seed(seed);
+        shadowPlayerCtrl.initialize(shadowPlayer);
+        spawnMonsters(shadowMonsters, shadowCtrls, opt.monsters, shadowPlayer,
+                      walls, opt, seed, flat);
+        for (auto* c : shadowCtrls) {
+            if (!routes.empty())
+                c->setRoutingTable(&routes);
+            if (opt.flowField)
+                c->setFlowFields(&shadowFlowFields);
+        }
+        if (opt.distField)
+            shadowPlayerCtrl.setDistanceField(&distField);
+    }
+    long firstMismatch = -1;
+    int  playerNode    = -1;
+    int  playerMoves   = 0;     // frames the player's closest node changed
+
+    int    peakExpansions = 0;
+    double worstFrameMs   = 0.0;
+
+    std::unique_ptr<DataRecorder> recorder;
+    if (opt.samplesPath) {
+        recorder.reset(new DataRecorder(opt.samplesPath));
+        if (!recorder->ok()) {
+            std::cerr << "headless: can't write samples to " << opt.samplesPath << "\n";
+            return 1;
+        }
+    }
+
+    // 3) fixed‐step loop (until the journal runs out, on --replay)
+    const long maxFrames = journal.replaying() || opt.wallclock
+                         ? LONG_MAX : std::lround(opt.seconds / opt.dt);
+    long   frames     = 0;
+    long   diverged   = -1;     // first frame whose checksum didn't match
+    double simSeconds = 0.0;
+    auto wallStart = std::chrono::steady_clock::now();
+    auto lastFrame = wallStart;
+    for (long f = 0; f < maxFrames; ++f) {
+        float dt = opt.dt;
+        if (opt.wallclock && !journal.replaying()) {
+            if (simSeconds >= opt.seconds)
+                break;
+            auto now = std::chrono::steady_clock::now();
+            if (f > 0)
+                dt = std::chrono::duration<float>(now - lastFrame).count();
+            lastFrame = now;
+        }
+        if (!journal.frame(dt))
+            break;
+        ++frames;
+        simSeconds += dt;
+
+        stepPlayer(player, playerCtrl, collision, dt);
+        if (opt.flowField && opt.checkParallel) {
+            int node = getClosestNode(player.position);
+            if (node != playerNode) {
+                playerNode = node;
+                ++playerMoves;
+            }
+        }
+        auto frameStart = std::chrono::steady_clock::now();
+        stepMonsterAgents(monsters, monsterCtrls, player, collision, dt, pool.get());
+        if (opt.budget > 0) {
+            scheduler.update();
+            peakExpansions = std::max(peakExpansions, scheduler.expandedLastFrame());
+        }
+        worstFrameMs = std::max(worstFrameMs, std::chrono::duration<double, std::milli>(
+                                    std::chrono::steady_clock::now() - frameStart).count());
+        if (opt.checkParallel && firstMismatch < 0) {
+            stepPlayer(shadowPlayer, shadowPlayerCtrl, collision, dt);
+            stepMonsterAgents(shadowMonsters, shadowCtrls, shadowPlayer, collision, dt);
+            if (!sameAgents(monsters, shadowMonsters) ||
+                shadowPlayer.position != player.position ||
+                shadowPlayer.velocity != player.velocity)
+                firstMismatch = f;
+        }
+        if (recorder)
+            for (std::size_t i = 0; i < monsters.size(); ++i)
+                recorder->record(makeSample(monsters.get(i), player,
+                                            *monsterCtrls[i], collision));
+        if (!journal.check(worldChecksum(player, monsters))) {
+            diverged = f;
+            break;
+        }
+    }
+    std::chrono::duration<double> wall =
+        std::chrono::steady_clock::now() - wallStart;
+
+    // 4) report
+    double wallSeconds = std::max(wall.count(), 1e-9);
+    std::cout << "graph build:       " << build.seconds * 1000.0 << " ms, "
+                                        << build.nodes << " nodes, "
+                                        << (build.graphBytes + build.csrBytes) / 1024 << " KiB\n"
+              << "frames:            " << frames << "\n"
+              << "simulated seconds: " << simSeconds << "\n"
+              << "wall seconds:      " << wall.count() << "\n"
+              << "frames/sec:        " << frames / wallSeconds << "\n"
+              << "sim‐sec/wall‐sec:  " << simSeconds / wallSeconds << "\n"
+              << "final player:      (" << player.position.x << ", "
+                                        << player.position.y << ")\n"
+              << "final monster 0:   (" << monsters.positions()[0].x << ", "
+                                        << monsters.positions()[0].y << ")\n";
+    std::cout << "worst monster ms:  " << worstFrameMs << "\n";
+    std::cout << "monster spawn ms:  " << spawnMs;
+    if (flat)
+        std::cout << " (one shared flat tree, " << flatTree.size() << " nodes, "
+                  << flatTree.bytes() << " bytes)";
+    std::cout << "\n";
+    std::cout << "seed:              " << seed << "\n";
+    if (journal.recording())
+        std::cout << "journal:           " << frames << " frames, " << journal.checks()
+                  << " checksums -> " << opt.recordPath << "\n";
+    if (journal.replaying()) {
+        if (diverged < 0)
+            std::cout << "replay:            " << frames << " frames, all "
+                      << journal.checks() << " checksums match\n";
+        else
+            std::cout << "replay:            DIVERGED, checksum after frame " << diverged + 1
+                      << " differs (" << journal.checks() << " matched before it)\n";
+    }
+    if (pool)
+        std::cout << "pool steals:       " << pool->steals() << "\n";
+    bool fieldsShared = true;
+    if (opt.checkParallel) {
+        if (firstMismatch < 0)
+            std::cout << "parallel check:    all " << frames << " frames match the serial run\n";
+        else
+            std::cout << "parallel check:    FAILED, serial run diverges at frame "
+                      << firstMismatch << "\n";
+        // at most one build per node the player moved to, however many chase it
+        if (opt.flowField && (flowFields.rebuilds() > playerMoves ||
+                              shadowFlowFields.rebuilds() > playerMoves)) {
+            std::cout << "parallel check:    FAILED, " << flowFields.rebuilds() << " / "
+                      << shadowFlowFields.rebuilds() << " flow field builds (parallel / serial)"
+                      << " for " << playerMoves << " player node changes\n";
+            fieldsShared = false;
+        }
+    }
+    if (recorder) {
+        recorder->close();   // joins the writer, so the file is complete
+        std::cout << "samples:           " << recorder->recorded() << " to "
+                  << opt.samplesPath << " (" << recorder->stalls()
+                  << " waited for the writer)";
+        if (!recorder->ok())
+            std::cout << ", WRITE FAILED";
+        std::cout << "\n";
+    }
+    if (opt.flowField)
+    {
+        std::cout << "flow field builds: " << flowFields.rebuilds();
+        if (opt.checkParallel)
+            std::cout << " (player changed node " << playerMoves << " times)";
+        std::cout << "\n";
+    }
+    if (opt.budget > 0)
+        std::cout << "peak expansions:   " << peakExpansions << " / frame (budget "
+                  << opt.budget << "), " << scheduler.pending() << " still queued\n";
+
+    for (auto* c : monsterCtrls)
+        delete c;
+    for (auto* c : shadowCtrls)
+        delete c;
+    journal.close();
+    return firstMismatch < 0 && diverged < 0 && fieldsShared ? 0 : 2;
+}
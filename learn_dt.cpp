@@ -0,0 +1,597 @@
+// learn_dt.cpp
+//
+// Native version of learn_dt.py: ID3 over DataRecorder samples, either its
+// binary files or monster_data.csv text (room,dist,aggro,wall,action),
+// printing the same JSON tree schema to stdout, so LearnedDecisionTree /
+// dtgen take either one's output.
+//
+// Differences from the script:
+//   - dist thresholds are the best split point over all distinct values
+//     (midpoints between neighbors, sort‐based), not just 100/200/300/400;
+//     --thresholds 100,200,300,400 restores the script's candidates and
+//     then reproduces its tree.
+//   - the rows are sorted by dist once; every node keeps its rows in that
+//     order, so a dist split is a cut and a nominal split a stable
+//     partition, with no per‐candidate subsets.
+//   - split search on large nodes is spread over a ThreadPool.
+//   - --max-depth caps the tree (0 = unlimited, like the script).
+//
+//   ./learn_dt [samples.bin|.csv] [--threads T] [--max-depth D]
+//              [--thresholds a,b,...] [-o tree.json]
+
+#include <vector>
+#include <string>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <numeric>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+#include "SampleLog.hpp"       // for DataRecorder's binary files
+
+// ——— samples ————————————————————————————————————————————————————————
+
+static const int kMaxLabels = 16;
+static const int kNominal   = 3;     // room, aggro, wall (in split order)
+static const int kMaxValue  = 256;   // nominal values are 0..255
+static const char* kNominalName[kNominal] = { "room", "aggro", "wall" };
+
+struct Samples {
+    std::vector<uint8_t>     nominal[kNominal];
+    std::vector<float>       dist;
+    std::vector<uint8_t>     label;
+    std::vector<std::string> labels;    // id → name, in order of first use
+    std::size_t size() const { return dist.size(); }
+};
+
+static int splitFields(char* line, char** fields, int maxFields) {
+    int n = 0;
+    fields[n++] = line;
+    for (char* p = line; *p && n < maxFields; ++p)
+        if (*p == ',') {
+            *p = '\0';
+            fields[n++] = p + 1;
+        }
+    return n;
+}
+
+// label id for name, adding it on first use; -1 once kMaxLabels are taken
+static int labelId(Samples& s, const std::string& name) {
+    int id = int(std::find(s.labels.begin(), s.labels.end(), name) - s.labels.begin());
+    if (id == (int)s.labels.size()) {
+        if (id == kMaxLabels)
+            return -1;
+        s.labels.push_back(name);
+    }
+    return id;
+}
+
+// a mapped DataRecorder file, column by column
+static void loadRecords(const SampleLog& log, Samples& s, long& skipped) {
+    log.adviseSequential();
+    const std::size_t n = log.size();
+    for (int c = 0; c < kNominal; ++c)
+        s.nominal[c].reserve(n);
+    s.dist.reserve(n);
+    s.label.reserve(n);
+
+    int ids[256];
+    std::fill(ids, ids + 256, -2);   // -2: action byte not seen yet
+    SampleColumn<SampleRoom>   room   = log.roomId();
+    SampleColumn<SampleAggro>  aggro  = log.inAggro();
+    SampleColumn<SampleWall>   wall   = log.hittingWall();
+    SampleColumn<SampleDist>   dist   = log.distToPlayer();
+    SampleColumn<SampleAction> action = log.action();
+    for (std::size_t i = 0; i < n; ++i) {
+        uint8_t a  = uint8_t(action[i]);
+        int&    id = ids[a];
+        if (id == -2)
+            id = a <= uint8_t(MonsterAction::Reset) ? labelId(s, actionName(action[i])) : -1;
+        if (id < 0) {
+            ++skipped;
+            continue;
+        }
+        s.nominal[0].push_back(uint8_t(room[i]));
+        s.nominal[1].push_back(aggro[i]);
+        s.nominal[2].push_back(wall[i]);
+        s.dist.push_back(dist[i]);
+        s.label.push_back(uint8_t(id));
+    }
+}
+
+static bool loadSamples(const char* path, Samples& s, long& skipped) {
+    skipped = 0;
+    SampleLog log;
+    if (log.open(path)) {
+        loadRecords(log, s, skipped);
+        return true;
+    }
+
+    // otherwise monster_data.csv text
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f)
+        return false;
+    std::vector<char> buf;
+    char chunk[1 << 16];
+    for (std::size_t got; (got = std::fread(chunk, 1, sizeof(chunk), f)) > 0; )
+        buf.insert(buf.end(), chunk, chunk + got);
+    std::fclose(f);
+    buf.push_back('\0');
+
+    // columns by header name, like csv.DictReader
+    char* line = buf.data();
+    char* next = std::strchr(line, '\n');
+    if (!next)
+        return false;
+    *next = '\0';
+    char* fields[16];
+    int  nf = splitFields(line, fields, 16);
+    int  col[5] = { -1, -1, -1, -1, -1 };   // room, aggro, wall, dist, action
+    const char* names[5] = { "room", "aggro", "wall", "dist", "action" };
+    for (int i = 0; i < nf; ++i) {
+        std::size_t len = std::strcspn(fields[i], "\r");
+        for (int c = 0; c < 5; ++c)
+            if (std::strlen(names[c]) == len && !std::strncmp(fields[i], names[c], len))
+                col[c] = i;
+    }
+    for (int c = 0; c < 5; ++c)
+        if (col[c] < 0)
+            return false;
+
+    for (line = next + 1; *line; line = next + 1) {
+        next = std::strchr(line, '\n');
+        if (!next)
+            next = line + std::strlen(line) - 1;   // last line, no newline
+        else
+            *next = '\0';
+        if (!*line)
+            continue;
+        nf = splitFields(line, fields, 16);
+        bool ok = true;
+        for (int c = 0; c < 5; ++c)
+            ok = ok && col[c] < nf;    // a short row lacks some columns
+        long v[kNominal];
+        for (int c = 0; ok && c < kNominal; ++c) {
+            char* end;
+            v[c] = std::strtol(fields[col[c]], &end, 10);
+            ok = end != fields[col[c]] && v[c] >= 0 && v[c] < kMaxValue;
+        }
+        char* end = nullptr;
+        float d = ok ? std::strtof(fields[col[3]], &end) : 0.f;
+        ok = ok && end != fields[col[3]];
+        std::string name = ok ? std::string(fields[col[4]], std::strcspn(fields[col[4]], "\r")) : "";
+        ok = ok && !name.empty();
+        if (!ok) {
+            ++skipped;
+            continue;
+        }
+        int id = labelId(s, name);
+        if (id < 0) {
+            ++skipped;
+            continue;
+        }
+        for (int c = 0; c < kNominal; ++c)
+            s.nominal[c].push_back((uint8_t)v[c]);
+        s.dist.push_back(d);
+        s.label.push_back((uint8_t)id);
+    }
+    return true;
+}
+
+// ——— learner ————————————————————————————————————————————————————————
+
+struct Counts {
+    std::array<uint32_t, kMaxLabels> n{};
+    uint32_t total = 0;
+    void add(uint8_t label) { ++n[label]; ++total; }
+    void add(const Counts& o) {
+        for (int k = 0; k < kMaxLabels; ++k) n[k] += o.n[k];
+        total += o.total;
+    }
+};
+
+static double entropy(const Counts& c, int labels) {
+    double h = 0.0;
+    for (int k = 0; k < labels; ++k)
+        if (c.n[k]) {
+            double p = double(c.n[k]) / c.total;
+            h -= p * std::log2(p);
+        }
+    return h;
+}
+
+struct Options {
+    int                threads  = 0;
+    int                maxDepth = 0;
+    std::vector<float> thresholds;   // empty = every midpoint
+    const char*        input    = "monster_data.csv";
+    const char*        output   = nullptr;
+};
+
+class Learner {
+public:
+    Learner(const Samples& s, const Options& opt, ThreadPool& pool)
+      : s_(s), opt_(opt), pool_(pool), labels_((int)s.labels.size()) {}
+
+    void build(std::vector<uint32_t>& rows, unsigned attrs, int depth,
+               std::ostream& out, int indent);
+
+    int nodes = 0, leaves = 0, deepest = 0;
+
+private:
+    // nodes smaller than this are searched on the calling thread
+    static const std::size_t kParallelRows = 1 << 16;
+
+    const Samples& s_;
+    const Options& opt_;
+    ThreadPool&    pool_;
+    int            labels_;
+    // per‐chunk [attr][value][label] counts, reused across nodes
+    std::vector<uint32_t> hist_;
+
+    struct Best {
+        int    attr   = -1;      // 0..2 nominal, 3 = dist
+        double gain   = -1.0;
+        std::size_t cut = 0;     // dist: rows [0, cut) go left
+        float  thresh = 0.f;
+    };
+
+    // run body(begin, end) over [0, n), in parallel for big nodes
+    template <class F>
+    void forChunks(std::size_t n, std::size_t chunks, F body) {
+        if (n < kParallelRows || chunks == 1) {
+            body(std::size_t(0), n, std::size_t(0));
+            return;
+        }
+        std::size_t per = (n + chunks - 1) / chunks;
+        pool_.parallelFor(chunks, 1, [&](std::size_t b, std::size_t e) {
+            for (std::size_t c = b; c < e; ++c)
+                body(std::min(n, c * per), std::min(n, (c + 1) * per), c);
+        });
+    }
+
+    int  majority(const std::vector<uint32_t>& rows, const Counts& total) const;
+    Best searchSplit(const std::vector<uint32_t>& rows, unsigned attrs, Counts& total);
+    void leaf(std::ostream& out, int indent, int label, int depth);
+};
+
+static void pad(std::ostream& out, int indent) {
+    for (int i = 0; i < indent; ++i) out << ' ';
+}
+
+static std::string formatThreshold(float t) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%.9g", t);   // round‐trips a float
+    return buf;
+}
+
+// Counter.most_common(1): highest count, ties to the label seen first
+int Learner::majority(const std::vector<uint32_t>& rows, const Counts& total) const {
+    uint32_t best = 0;
+    for (int k = 0; k < labels_; ++k)
+        best = std::max(best, total.n[k]);
+    // rows are in dist order, not file order: find the earliest row
+    uint32_t firstRow = UINT32_MAX;
+    int      label    = 0;
+    for (uint32_t r : rows) {
+        int k = s_.label[r];
+        if (total.n[k] == best && r < firstRow) {
+            firstRow = r;
+            label    = k;
+        }
+    }
+    return label;
+}
+
+Learner::Best Learner::searchSplit(const std::vector<uint32_t>& rows, unsigned attrs,
+                                   Counts& total)
+{
+    const std::size_t n      = rows.size();
+    const std::size_t chunks = n < kParallelRows ? 1 : pool_.size() * 4;
+
+    // pass 1: label counts per nominal value, and per chunk (for the dist
+    // prefix sums); each chunk counts into its own slice of hist_
+    const std::size_t slice = std::size_t(kNominal) * kMaxValue * labels_;
+    if (hist_.size() < chunks * slice)
+        hist_.resize(chunks * slice);
+    std::vector<Counts> chunkCounts(chunks);
+    forChunks(n, chunks, [&](std::size_t b, std::size_t e, std::size_t c) {
+        uint32_t* h = &hist_[c * slice];
+        std::fill(h, h + slice, 0u);
+        for (std::size_t i = b; i < e; ++i) {
+            uint32_t r = rows[i];
+            uint8_t  k = s_.label[r];
+            chunkCounts[c].add(k);
+            for (int a = 0; a < kNominal; ++a)
+                if (attrs & (1u << a))
+                    ++h[(a * kMaxValue + s_.nominal[a][r]) * labels_ + k];
+        }
+    });
+    for (std::size_t c = 0; c < chunks; ++c)
+        total.add(chunkCounts[c]);
+    for (std::size_t c = 1; c < chunks; ++c)
+        for (std::size_t i = 0; i < slice; ++i)
+            hist_[i] += hist_[c * slice + i];
+
+    const double h0 = entropy(total, labels_);
+    Best best;
+
+    // nominal attributes, in the script's order; strictly better wins
+    for (int a = 0; a < kNominal; ++a) {
+        if (!(attrs & (1u << a)))
+            continue;
+        double h1 = 0.0;
+        for (int v = 0; v < kMaxValue; ++v) {
+            Counts cv;
+            for (int k = 0; k < labels_; ++k) {
+                cv.n[k]   = hist_[(a * kMaxValue + v) * labels_ + k];
+                cv.total += cv.n[k];
+            }
+            if (cv.total)
+                h1 += double(cv.total) / n * entropy(cv, labels_);
+        }
+        double gain = h0 - h1;
+        if (gain > best.gain) {
+            best.attr = a;
+            best.gain = gain;
+        }
+    }
+
+    // dist, scanning the rows in dist order with running left counts
+    auto gainAt = [&](const Counts& left) {
+        Counts right = total;
+        for (int k = 0; k < labels_; ++k) right.n[k] -= left.n[k];
+        right.total -= left.total;
+        double h1 = double(left.total)  / n * entropy(left,  labels_)
+                  + double(right.total) / n * entropy(right, labels_);
+        return h0 - h1;
+    };
+
+    if (!opt_.thresholds.empty()) {
+        // the script's fixed candidates: left = dist <= t, both sides non‐empty
+        for (float t : opt_.thresholds) {
+            std::size_t cut = std::upper_bound(rows.begin(), rows.end(), t,
+                [&](float v, uint32_t r) { return v < s_.dist[r]; }) - rows.begin();
+            if (cut == 0 || cut == n)
+                continue;
+            Counts left;
+            for (std::size_t c = 0; c < chunks; ++c) {
+                // whole chunks below the cut come from the pass‐1 counts
+                std::size_t per = (n + chunks - 1) / chunks;
+                std::size_t b = std::min(n, c * per), e = std::min(n, (c + 1) * per);
+                if (e <= cut) { left.add(chunkCounts[c]); continue; }
+                for (std::size_t i = b; i < cut; ++i) left.add(s_.label[rows[i]]);
+                break;
+            }
+            double gain = gainAt(left);
+            if (gain > best.gain) {
+                best.attr   = 3;
+                best.gain   = gain;
+                best.cut    = cut;
+                best.thresh = t;
+            }
+        }
+        return best;
+    }
+
+    // every boundary between distinct values; each chunk scans its own
+    // range from its prefix counts, then the lowest cut of the best gain wins.
+    // A boundary between two runs of equal values that are both pure with
+    // the same label is never the best cut (Fayyad & Irani), so only cuts
+    // where the label can change pay for the entropy.
+    auto pureRun = [&](std::size_t i, int step, uint8_t k) {
+        float v = s_.dist[rows[i]];
+        for (std::size_t j = i; j < n && s_.dist[rows[j]] == v; j += step) {
+            if (s_.label[rows[j]] != k)
+                return false;
+            if (j == 0)
+                break;
+        }
+        return true;
+    };
+    std::vector<Counts> prefix(chunks);
+    for (std::size_t c = 1; c < chunks; ++c) {
+        prefix[c] = prefix[c - 1];
+        prefix[c].add(chunkCounts[c - 1]);
+    }
+    std::vector<Best> chunkBest(chunks);
+    forChunks(n, chunks, [&](std::size_t b, std::size_t e, std::size_t c) {
+        Counts left = prefix[c];
+        Best   mine;
+        for (std::size_t i = b; i < e; ++i) {
+            left.add(s_.label[rows[i]]);
+            if (i + 1 == n)
+                break;
+            float lo = s_.dist[rows[i]], hi = s_.dist[rows[i + 1]];
+            if (!(lo < hi))
+                continue;
+            uint8_t k = s_.label[rows[i]];
+            if (s_.label[rows[i + 1]] == k && pureRun(i, -1, k) && pureRun(i + 1, 1, k))
+                continue;
+            double gain = gainAt(left);
+            if (gain > mine.gain) {
+                mine.attr = 3;
+                mine.gain = gain;
+                mine.cut  = i + 1;
+                // the midpoint, unless it rounds onto hi (adjacent floats):
+                // the float threshold must split exactly like training did
+                float mid = float((double(lo) + double(hi)) / 2.0);
+                mine.thresh = mid < hi ? mid : lo;
+            }
+        }
+        chunkBest[c] = mine;
+    });
+    for (const Best& c : chunkBest)
+        if (c.attr == 3 && c.gain > best.gain)
+            best = c;
+    return best;
+}
+
+void Learner::leaf(std::ostream& out, int indent, int label, int depth) {
+    ++nodes;
+    ++leaves;
+    deepest = std::max(deepest, depth);
+    out << "{\n";
+    pad(out, indent + 2);
+    out << "\"label\": \"" << s_.labels[label] << "\"\n";
+    pad(out, indent);
+    out << "}";
+}
+
+// writes the subtree for `rows` (sorted by dist) as the script's JSON;
+// consumes rows
+void Learner::build(std::vector<uint32_t>& rows, unsigned attrs, int depth,
+                    std::ostream& out, int indent)
+{
+    Counts total;
+    bool pure = true;
+    for (std::size_t i = 1; i < rows.size() && pure; ++i)
+        pure = s_.label[rows[i]] == s_.label[rows[0]];
+    if (pure) {
+        leaf(out, indent, s_.label[rows[0]], depth);
+        return;
+    }
+    Best best = searchSplit(rows, attrs, total);
+    if (best.attr < 0 || best.gain < 1e-6 ||
+        (opt_.maxDepth > 0 && depth >= opt_.maxDepth)) {
+        leaf(out, indent, majority(rows, total), depth);
+        return;
+    }
+
+    ++nodes;
+    out << "{\n";
+    pad(out, indent + 2);
+    if (best.attr == 3) {
+        out << "\"attr\": \"dist\",\n";
+        pad(out, indent + 2);
+        out << "\"thresh\": " << formatThreshold(best.thresh) << ",\n";
+        // the rows are in dist order: the split is a cut
+        std::vector<uint32_t> right(rows.begin() + best.cut, rows.end());
+        rows.resize(best.cut);
+        rows.shrink_to_fit();
+        pad(out, indent + 2);
+        out << "\"le\": ";
+        build(rows, attrs, depth + 1, out, indent + 2);
+        out << ",\n";
+        pad(out, indent + 2);
+        out << "\"gt\": ";
+        build(right, attrs, depth + 1, out, indent + 2);
+        out << "\n";
+    } else {
+        out << "\"attr\": \"" << kNominalName[best.attr] << "\",\n";
+        pad(out, indent + 2);
+        out << "\"branches\": {\n";
+        // stable partition by value keeps every branch in dist order
+        const std::vector<uint8_t>& col = s_.nominal[best.attr];
+        std::vector<std::size_t> count(kMaxValue, 0);
+        for (uint32_t r : rows) ++count[col[r]];
+        std::vector<std::vector<uint32_t>> parts(kMaxValue);
+        for (int v = 0; v < kMaxValue; ++v) parts[v].reserve(count[v]);
+        for (uint32_t r : rows) parts[col[r]].push_back(r);
+        std::vector<uint32_t>().swap(rows);
+
+        bool first = true;
+        for (int v = 0; v < kMaxValue; ++v) {
+            if (parts[v].empty())
+                continue;
+            if (!first) out << ",\n";
+            first = false;
+            pad(out, indent + 4);
+            out << "\"" << v << "\": ";
+            build(parts[v], attrs & ~(1u << best.attr), depth + 1, out, indent + 4);
+            std::vector<uint32_t>().swap(parts[v]);
+        }
+        out << "\n";
+        pad(out, indent + 2);
+        out << "}\n";
+    }
+    pad(out, indent);
+    out << "}";
+}
+
+// ——— main ———————————————————————————————————————————————————————————
+
+static bool parseArgs(int argc, char** argv, Options& opt) {
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--threads") && hasValue)
+            opt.threads = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--max-depth") && hasValue)
+            opt.maxDepth = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--thresholds") && hasValue) {
+            std::stringstream list(argv[++i]);
+            for (std::string t; std::getline(list, t, ','); )
+                opt.thresholds.push_back(std::strtof(t.c_str(), nullptr));
+            std::sort(opt.thresholds.begin(), opt.thresholds.end());
+        }
+        else if (!std::strcmp(argv[i], "-o") && hasValue)
+            opt.output = argv[++i];
+        else if (argv[i][0] != '-')
+            opt.input = argv[i];
+        else
+            return false;
+    }
+    return opt.threads >= 0 && opt.maxDepth >= 0;
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        std::cerr << "usage: learn_dt [samples.bin|.csv] [--threads T] [--max-depth D]"
+                     " [--thresholds a,b,...] [-o tree.json]\n";
+        return 1;
+    }
+
+    using clock = std::chrono::steady_clock;
+    auto t0 = clock::now();
+    Samples s;
+    long skipped = 0;
+    if (!loadSamples(opt.input, s, skipped)) {
+        std::cerr << "learn_dt: can't read samples from " << opt.input << "\n";
+        return 1;
+    }
+    if (s.size() == 0) {
+        std::cerr << "learn_dt: no samples in " << opt.input << "\n";
+        return 1;
+    }
+    auto t1 = clock::now();
+
+    ThreadPool pool((unsigned)opt.threads);
+    std::vector<uint32_t> rows(s.size());
+    std::iota(rows.begin(), rows.end(), 0u);
+    // stable, so equal dists keep file order
+    std::stable_sort(rows.begin(), rows.end(),
+                     [&](uint32_t a, uint32_t b) { return s.dist[a] < s.dist[b]; });
+
+    std::ostringstream json;
+    Learner learner(s, opt, pool);
+    learner.build(rows, (1u << kNominal) - 1, 0, json, 0);
+    json << "\n";
+    auto t2 = clock::now();
+
+    if (opt.output) {
+        std::ofstream out(opt.output);
+        if (!(out << json.str())) {
+            std::cerr << "learn_dt: can't write " << opt.output << "\n";
+            return 1;
+        }
+    } else {
+        std::cout << json.str();
+    }
+
+    std::cerr << "learn_dt: " << s.size() << " samples (" << skipped << " skipped), "
+              << s.labels.size() << " labels, read in "
+              << std::chrono::duration<double>(t1 - t0).count() << " s; "
+              << learner.nodes << " nodes (" << learner.leaves << " leaves, depth "
+              << learner.deepest << ") learned in "
+              << std::chrono::duration<double>(t2 - t1).count() << " s on "
+              << pool.size() << " threads\n";
+    return 0;
+}
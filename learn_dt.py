@@ -1,11 +1,36 @@
 import csv
 import math
+import mmap
+import struct
+import sys
 from collections import Counter, defaultdict
 
-# load samples
-with open('monster_data.csv') as f:
-    reader = csv.DictReader(f)
-    data = list(reader)
+# load samples: monster_data.csv text, or a DataRecorder file (samples.bin)
+path = sys.argv[1] if len(sys.argv) > 1 else 'monster_data.csv'
+ACTIONS = ['wander', 'chase', 'reset']    # MonsterAction values
+
+def load_records(f):
+    # "MSMP", u32 version, u32 record size, u32 reserved, then records of
+    # f32 dist, u8 room, u8 flags (1 aggro, 2 wall), u8 action, u8 pad
+    m = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    magic, version, size, _ = struct.unpack_from('<4sIII', m)
+    if magic != b'MSMP' or version != 1 or size != 8:
+        sys.exit(path + ': unsupported sample file')
+    n = (len(m) - 16) // 8
+    return [{'room': room, 'dist': dist, 'aggro': flags & 1,
+             'wall': (flags >> 1) & 1, 'action': ACTIONS[action]}
+            for dist, room, flags, action, _ in
+                struct.iter_unpack('<fBBBB', memoryview(m)[16:16 + 8*n])
+            if action < len(ACTIONS)]
+
+with open(path, 'rb') as f:
+    binary = f.read(4) == b'MSMP'
+    if binary:
+        data = load_records(f)
+if not binary:
+    with open(path) as f:
+        reader = csv.DictReader(f)
+        data = list(reader)
 
 # convert fields
 for row in data:
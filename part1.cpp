@@ -7,6 +7,7 @@
 
 #include "Environment.hpp"     // declares drawSymmetricRoomLayout(), createGraphGrid(), isInsideWall(), extern graphNodes
 #include "Node.hpp"            // declares getClosestNode(), AStar()
+#include "PathSearchContext.hpp"
 #include "Steering.hpp"        // your Arrive/Align/Wander APIs
 
 int main() {
@@ -60,7 +61,7 @@ int main() {
                 int startIdx = getClosestNode(character.position);
                 int goalIdx  = getClosestNode({float(event.mouseButton.x),
                                                float(event.mouseButton.y)});
-                currentPath = AStar(startIdx, goalIdx);
+                threadPathContext().search(startIdx, goalIdx, currentPath);
                 currentPathIndex = 0;
                 frozen = false;
             }
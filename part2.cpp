@@ -5,11 +5,12 @@
 #include <cmath>
 #include <iostream>
 
-#include "Environment.hpp"       // extern graphNodes; drawSymmetricRoomLayout; createGraphGrid; isInsideWall
+#include "Environment.hpp"       // extern graphNodes; drawSymmetricRoomLayout; createGraphGrid
 #include "Node.hpp"              // getClosestNode; AStar
 #include "Steering.hpp"          // Kinematic, vectorLength, normalize, mapToRange
 #include "BehaviorController.hpp"
 #include "MonsterController.hpp"
+#include "CollisionGrid.hpp"
 
 using namespace std;
 
@@ -51,6 +52,8 @@ int main() {
     vector<sf::RectangleShape> walls;
     drawSymmetricRoomLayout(walls);
     createGraphGrid(graphNodes, walls, 24, 640, 480);
+    CollisionGrid collision;             // O(1) wall checks for the clamps
+    collision.build(walls);
 
     // 2) Player boid + controller + breadcrumbs
     Kinematic player{ graphNodes[0].position, {0,0}, 0.f, 0.f };
@@ -104,7 +107,7 @@ int main() {
         {
             auto prev = player.position;
             player.position += player.velocity * dt;
-            if (isInsideWall(player.position, walls)) {
+            if (collision.blocked(player.position)) {
                 player.position = prev;
                 player.velocity = {0,0};
             }
@@ -126,7 +129,7 @@ int main() {
         {
             auto prevM = monster.position;
             monsterCtrl.update(dt);
-            if (isInsideWall(monster.position, walls)) {
+            if (collision.blocked(monster.position)) {
                 monster.position = prevM;
                 monster.velocity = {0,0};
             }
@@ -1,16 +1,27 @@
 // part3.cpp
+//
+//   ./part3 [--seed S] [--record run.sjnl | --replay run.sjnl]
+//
+// --record journals every frame's dt so the run can be replayed exactly;
+// --replay runs on the journaled dts instead of the clock and closes the
+// window when they run out.
 
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <cmath>
 #include <iostream>
+#include <cstdlib>
+#include <cstring>
 
 #include "Node.hpp"            // for Node, extern graphNodes, getClosestNode, AStar
-#include "Environment.hpp"     // for drawSymmetricRoomLayout, createGraphGrid, isInsideWall
+#include "Environment.hpp"     // for drawSymmetricRoomLayout, createGraphGrid, getRoomId
 #include "Steering.hpp"        // for Kinematic, ArriveBehavior, AlignBehavior, vectorLength, mapToRange
 #include "BehaviorController.hpp"
 #include "MonsterController.hpp"
 #include "DataRecorder.hpp"    // for Sample, DataRecorder
+#include "CollisionGrid.hpp"   // for CollisionGrid
+#include "SimJournal.hpp"      // for --record / --replay
+#include "Rng.hpp"
 
 // ————————————————————————————————————————————————————————————————————————————————
 // breadcrumb types
@@ -36,24 +47,36 @@ struct BoidBreadcrumbs {
     }
 };
 
-// ————————————————————————————————————————————————————————————————————————————————
-// which of the 4 rooms am I in?
-//———————————————————————————————————————————————————————————————————————————————
-int getRoomId(const sf::Vector2f& pos) {
-    bool right = pos.x >= 320.f;
-    bool down  = pos.y >= 240.f;
-    if (!right && !down) return 0;
-    if ( right && !down) return 1;
-    if (!right &&  down) return 2;
-    return 3;
-}
+int main(int argc, char** argv) {
+    // 0) seed and journal
+    uint64_t    seed       = 1;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if      (!std::strcmp(argv[i], "--seed"))   seed       = std::strtoull(argv[i+1], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--record")) recordPath = argv[i+1];
+        else if (!std::strcmp(argv[i], "--replay")) replayPath = argv[i+1];
+    }
+    SimJournal journal;
+    if (replayPath) {
+        if (!journal.replay(replayPath)) {
+            std::cerr << "Failed to read journal " << replayPath << "\n";
+            return -1;
+        }
+        seed = journal.seed();
+    } else if (recordPath && !journal.record(recordPath, seed, "part3")) {
+        std::cerr << "Failed to create journal " << recordPath << "\n";
+        return -1;
+    }
+    Rng::seedAgents(seed);
 
-int main() {
     // 1) set up window & environment
     sf::RenderWindow window({640,480}, "Part3");
     std::vector<sf::RectangleShape> walls;
     drawSymmetricRoomLayout(walls);
     createGraphGrid(graphNodes, walls, 24, 640, 480);
+    CollisionGrid collision;           // O(1) wall checks for clamps & probe
+    collision.build(walls);
 
     // 2) player boid + behavior‐tree controller
     Kinematic player;
@@ -77,8 +100,10 @@ int main() {
         /*eatRadius=*/30.f
     );
 
-    // 4) data recorder
-    DataRecorder recorder("monster_data.csv");
+    // 4) data recorder (binary; samples2csv monster_data.bin > monster_data.csv)
+    DataRecorder recorder("monster_data.bin");
+    if (!recorder.ok())
+        std::cerr << "part3: can't write monster_data.bin, samples are dropped\n";
 
     // 5) breadcrumb trails
     BoidBreadcrumbs playerCrumbs(sf::Color(100,100,100,180));
@@ -107,6 +132,10 @@ int main() {
                 window.close();
 
         float dt = clock.restart().asSeconds();
+        if (!journal.frame(dt)) {       // replay finished
+            window.close();
+            break;
+        }
 
         // — update player via its BT, clamp to walls —
         SteeringOutput ps = playerCtrl.update(player, dt);
@@ -114,7 +143,7 @@ int main() {
         {
             sf::Vector2f prev = player.position;
             player.position += player.velocity * dt;
-            if (isInsideWall(player.position, walls)) {
+            if (collision.blocked(player.position)) {
                 player.position = prev;
                 player.velocity = {0.f,0.f};
             }
@@ -137,7 +166,7 @@ int main() {
         {
             sf::Vector2f prev = monster.position;
             monsterCtrl.update(dt);
-            if (isInsideWall(monster.position, walls)) {
+            if (collision.blocked(monster.position)) {
                 monster.position = prev;
                 monster.velocity = {0.f,0.f};
             }
@@ -161,10 +190,17 @@ int main() {
         sf::Vector2f probe = monster.position +
             sf::Vector2f(std::cos(monster.orientation),
                          std::sin(monster.orientation)) * 10.f;
-        s.hittingWall  = isInsideWall(probe, walls);
-        s.action       = monsterCtrl.getLastActionName();
+        s.hittingWall  = collision.blocked(probe);
+        s.action       = monsterCtrl.getLastAction();
         recorder.record(s);
 
+        // — journal checksum —
+        if (!journal.check(SimJournal::hash(monster, SimJournal::hash(player)))) {
+            std::cerr << "Replay diverged after frame " << journal.frames() << "\n";
+            window.close();
+            break;
+        }
+
         // — draw —
         window.clear(sf::Color::White);
 
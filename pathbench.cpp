@@ -0,0 +1,203 @@
+// pathbench.cpp
+//
+// Compares the grid A* (PathSearchContext, what AStar() runs) with Jump
+// Point Search and HPA* on the four‐room map and on bigger generated room
+// grids: nodes expanded and time per query over the same random node pairs.
+// JPS must match the A* cost exactly; for HPA* (plan + every leg refined)
+// the extra path length is reported.
+//
+// With --threads T the A* queries are also pushed through an
+// AsyncPathService with T workers (0 = all cores) to measure throughput.
+//
+//   ./pathbench [--queries N] [--seed S] [--threads T]
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <string>
+
+#include "Node.hpp"
+#include "Environment.hpp"
+#include "PathSearchContext.hpp"
+#include "NavGraph.hpp"
+#include "JumpPointSearch.hpp"
+#include "HierarchicalPlanner.hpp"
+#include "AsyncPathService.hpp"
+#include <future>
+
+struct BenchMap {
+    std::string name;
+    std::vector<sf::RectangleShape> walls;
+    int width, height;
+    HierarchicalPlanner::RegionFn region;   // rooms, for HPA*
+};
+
+static float pathCost(const std::vector<int>& path) {
+    float c = 0.f;
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        sf::Vector2f d = graphNodes[path[i]].position - graphNodes[path[i-1]].position;
+        c += std::sqrt(d.x*d.x + d.y*d.y);
+    }
+    return c;
+}
+
+static void runMap(const BenchMap& map, int queries, unsigned seed, int threads) {
+    const int spacing = 24;
+    graphNodes.clear();
+    GraphBuildStats build;
+    createGraphGrid(graphNodes, map.walls, spacing, map.width, map.height, &build);
+    int n = (int)graphNodes.size();
+
+    JumpPointSearch jps;
+    if (!jps.build(graphNodes, (float)spacing)) {
+        std::cout << map.name << ": not a 4‐connected lattice, skipped\n";
+        return;
+    }
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> pick(0, n - 1);
+    std::vector<std::pair<int,int>> pairs(queries);
+    for (auto& p : pairs)
+        p = { pick(rng), pick(rng) };
+
+    PathSearchContext& astar = threadPathContext();
+    std::vector<int> path;
+    path.reserve(n);
+    std::vector<float> astarCost(queries);
+    using clock = std::chrono::steady_clock;
+
+    long astarExpanded = 0, jpsExpanded = 0;
+    auto t0 = clock::now();
+    for (int i = 0; i < queries; ++i) {
+        astar.search(pairs[i].first, pairs[i].second, path);
+        astarExpanded += astar.expanded();
+        astarCost[i] = path.empty() ? -1.f : pathCost(path);
+    }
+    auto t1 = clock::now();
+    int mismatches = 0;
+    for (int i = 0; i < queries; ++i) {
+        jps.search(pairs[i].first, pairs[i].second, path);
+        jpsExpanded += jps.expanded();
+        float c = path.empty() ? -1.f : pathCost(path);
+        if (std::fabs(c - astarCost[i]) > 1e-3f * std::max(1.f, c))
+            ++mismatches;
+    }
+    auto t2 = clock::now();
+
+    HierarchicalPlanner hpa;
+    hpa.build(graphNodes, map.region);
+    std::vector<int> leg;
+    HpaRoute route;
+    long hpaExpanded = 0;
+    int  hpaFailures = 0;
+    double extraSum = 0.0, extraMax = 0.0;
+    auto t3 = clock::now();
+    for (int i = 0; i < queries; ++i) {
+        hpa.plan(pairs[i].first, pairs[i].second, route);
+        hpaExpanded += hpa.expanded();
+        path.clear();
+        while (hpa.refineNext(route, leg)) {
+            hpaExpanded += hpa.expanded();
+            path.insert(path.end(), leg.begin(), leg.end());
+        }
+        float c = path.empty() ? -1.f : pathCost(path);
+        if ((c < 0.f) != (astarCost[i] < 0.f)) {
+            ++hpaFailures;
+        } else if (astarCost[i] > 0.f) {
+            double extra = c / astarCost[i] - 1.0;
+            extraSum += extra;
+            extraMax  = std::max(extraMax, extra);
+        }
+    }
+    auto t4 = clock::now();
+
+    auto usPer = [&](clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count() / queries;
+    };
+    std::cout << map.name << ": " << n << " nodes (" << jps.cols() << "x"
+              << jps.rows() << " cells), " << queries << " queries\n"
+              << std::fixed << std::setprecision(1)
+              << "  graph build:         " << build.seconds * 1000.0 << " ms, "
+              << build.graphBytes / 1024 << " KiB as Node vector, "
+              << build.csrBytes / 1024 << " KiB as CSR\n"
+              << "  A*   expanded/query: " << std::setw(8) << double(astarExpanded) / queries
+              << "   " << std::setprecision(2) << usPer(t1 - t0) << " us/query\n"
+              << std::setprecision(1)
+              << "  JPS  expanded/query: " << std::setw(8) << double(jpsExpanded) / queries
+              << "   " << std::setprecision(2) << usPer(t2 - t1) << " us/query\n"
+              << "  JPS cost mismatches: " << mismatches << "\n"
+              << std::setprecision(1)
+              << "  HPA* expanded/query: " << std::setw(8) << double(hpaExpanded) / queries
+              << "   " << std::setprecision(2) << usPer(t4 - t3) << " us/query"
+              << "  (" << hpa.regionCount() << " regions, " << hpa.entranceNodes()
+              << " entrance nodes, built in " << hpa.buildSeconds() * 1000.0 << " ms)\n"
+              << "  HPA* extra length:   " << 100.0 * extraSum / queries << "% mean, "
+              << 100.0 * extraMax << "% max, " << hpaFailures << " failures\n";
+
+    if (threads >= 0) {
+        AsyncPathService service(snapshotNavGraph(), (unsigned)threads);
+        std::vector<std::future<std::vector<int>>> results;
+        results.reserve(queries);
+        auto t5 = clock::now();
+        for (auto& p : pairs)
+            results.push_back(service.request(p.first, p.second));
+        int asyncMismatches = 0;
+        for (int i = 0; i < queries; ++i) {
+            std::vector<int> r = results[i].get();
+            float c = r.empty() ? -1.f : pathCost(r);
+            if (std::fabs(c - astarCost[i]) > 1e-3f * std::max(1.f, c))
+                ++asyncMismatches;
+        }
+        auto t6 = clock::now();
+        std::cout << "  async A* (" << service.threads() << " threads): "
+                  << std::setprecision(2) << usPer(t6 - t5) << " us/query wall, "
+                  << asyncMismatches << " cost mismatches\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+int main(int argc, char** argv) {
+    int      queries = 2000;
+    unsigned seed    = 1;
+    int      threads = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--queries") && i + 1 < argc)
+            queries = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = (unsigned)std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+        else {
+            std::cerr << "usage: pathbench [--queries N] [--seed S] [--threads T]\n";
+            return 1;
+        }
+    }
+    if (queries <= 0)
+        queries = 1;
+
+    std::vector<BenchMap> maps;
+    maps.push_back({ "four‐room", {}, 640, 480, getRoomId });
+    drawSymmetricRoomLayout(maps.back().walls);
+
+    const int spacing = 24, roomCells = 10;
+    const int grids[][2] = { { 4, 3 }, { 8, 6 }, { 16, 12 } };
+    for (auto& g : grids) {
+        BenchMap m{ "rooms " + std::to_string(g[0]) + "x" + std::to_string(g[1]), {},
+                    (g[0]*roomCells + 2) * spacing, (g[1]*roomCells + 2) * spacing,
+                    // room walls sit on lattice lines 1, 1+roomCells, ...
+                    blockRegions((float)(roomCells * spacing),
+                                 { (float)spacing, (float)spacing }) };
+        drawRoomGridLayout(m.walls, g[0], g[1], roomCells, spacing, seed);
+        maps.push_back(m);
+    }
+
+    for (auto& m : maps)
+        runMap(m, queries, seed, threads);
+    return 0;
+}
@@ -0,0 +1,72 @@
+// samples2csv.cpp
+//
+// Converts a DataRecorder sample file back into the monster_data.csv text
+// that learn_dt.py reads (room,dist,aggro,wall,action), formatted exactly
+// like the old text recorder did.
+//
+//   ./samples2csv samples.bin [-o out.csv]      (stdout by default)
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <iostream>
+
+#include "SampleLog.hpp"
+
+int main(int argc, char** argv) {
+    const char* input  = nullptr;
+    const char* output = nullptr;
+    bool        usage  = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-o") && i + 1 < argc)
+            output = argv[++i];
+        else if (argv[i][0] != '-' && !input)
+            input = argv[i];
+        else
+            usage = true;
+    }
+    if (usage || !input) {
+        std::cerr << "usage: samples2csv samples.bin [-o out.csv]\n";
+        return 1;
+    }
+
+    SampleLog   log;
+    std::string error;
+    if (!log.open(input, &error)) {
+        std::cerr << "samples2csv: " << error << "\n";
+        return 1;
+    }
+    log.adviseSequential();
+    std::FILE* out = output ? std::fopen(output, "w") : stdout;
+    if (!out) {
+        std::cerr << "samples2csv: can't write " << output << "\n";
+        return 1;
+    }
+    std::setvbuf(out, nullptr, _IOFBF, 1 << 20);
+
+    std::fprintf(out, "room,dist,aggro,wall,action\n");
+    const std::size_t rows = log.size();
+    long long bad = 0;
+    for (std::size_t i = 0; i < rows; ++i) {
+        const SampleRecord& r = log.records()[i];
+        if (r.action > uint8_t(MonsterAction::Reset)) {
+            ++bad;
+            continue;
+        }
+        Sample s = unpackSample(r);
+        std::fprintf(out, "%d,%g,%d,%d,%s\n", s.roomId, s.distToPlayer,
+                     s.inAggro ? 1 : 0, s.hittingWall ? 1 : 0,
+                     actionName(s.action));
+    }
+    bool failed = std::fflush(out) != 0;
+    if (output && std::fclose(out) != 0)
+        failed = true;
+    if (failed) {
+        std::cerr << "samples2csv: I/O error\n";
+        return 1;
+    }
+    if (bad)
+        std::cerr << "samples2csv: skipped " << bad << " of " << rows
+                  << " records with an unknown action\n";
+    return 0;
+}